@@ -0,0 +1,14 @@
+// bindless resources: runtime sized descriptor arrays of BindlessDescriptors (bindless_descriptors.hpp), indexed by slot
+// kernels enable GL_EXT_nonuniform_qualifier before including this header
+// usage: BINDLESS_STORAGE_IMAGE(rgba8ui) uimage2D images[];  BINDLESS_STORAGE_BUFFER Block { ... } blocks[];
+#ifndef VKC_BINDLESS_GLSL
+#define VKC_BINDLESS_GLSL
+
+// descriptor set of bindless resources (BindlessSet of layout_cache.hpp)
+#define VKC_BINDLESS_SET 2
+
+// storage image array (binding 0) and storage buffer array (binding 1), one declaration per image format / block type
+#define BINDLESS_STORAGE_IMAGE(format) layout(set = VKC_BINDLESS_SET, binding = 0, format) uniform
+#define BINDLESS_STORAGE_BUFFER layout(set = VKC_BINDLESS_SET, binding = 1, std430) buffer
+
+#endif
@@ -0,0 +1,41 @@
+// color conversion and packing helpers
+#ifndef VKC_COLOR_GLSL
+#define VKC_COLOR_GLSL
+
+// unorm color [0,1] to 8-bit unsigned components
+uvec4 ColorToUnorm8(vec4 color) {
+    return uvec4(clamp(color, 0.0, 1.0) * 255.0 + 0.5);
+}
+
+// 8-bit unsigned components to unorm color
+vec4 Unorm8ToColor(uvec4 value) {
+    return vec4(value & 0xffu) / 255.0;
+}
+
+// pack 8-bit components into one word (r in low byte)
+uint PackUnorm8(uvec4 value) {
+    value &= 0xffu;
+    return value.r | (value.g << 8) | (value.b << 16) | (value.a << 24);
+}
+
+// unpack one word into 8-bit components
+uvec4 UnpackUnorm8(uint value) {
+    return uvec4(value, value >> 8, value >> 16, value >> 24) & 0xffu;
+}
+
+// sRGB to linear
+vec3 SrgbToLinear(vec3 color) {
+    return mix(color / 12.92, pow((color + 0.055) / 1.055, vec3(2.4)), greaterThan(color, vec3(0.04045)));
+}
+
+// linear to sRGB
+vec3 LinearToSrgb(vec3 color) {
+    return mix(color * 12.92, 1.055 * pow(color, vec3(1.0 / 2.4)) - 0.055, greaterThan(color, vec3(0.0031308)));
+}
+
+// Rec. 709 luminance of linear color
+float Luminance(vec3 color) {
+    return dot(color, vec3(0.2126, 0.7152, 0.0722));
+}
+
+#endif
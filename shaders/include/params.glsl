@@ -0,0 +1,16 @@
+// kernel parameters: push constants, or uniform buffer of parameter ring when VKC_PARAMS_UBO is defined
+// (parameters larger than maxPushConstantsSize of device), block is std140 in both cases so host struct is the same
+// usage: KERNEL_PARAMS Params { ... };
+#ifndef VKC_PARAMS_GLSL
+#define VKC_PARAMS_GLSL
+
+// descriptor set of spilled parameters (KernelParamsSet of layout_cache.hpp)
+#define VKC_PARAMS_SET 1
+
+#ifdef VKC_PARAMS_UBO
+#define KERNEL_PARAMS layout(set = VKC_PARAMS_SET, binding = 0, std140) uniform
+#else
+#define KERNEL_PARAMS layout(push_constant, std140) uniform
+#endif
+
+#endif
@@ -0,0 +1,14 @@
+// buffer pointers: buffer reference blocks (GL_EXT_buffer_reference) whose device addresses are kernel arguments in push constants
+// (DevicePointer<T> members of host argument structs, kernel_args.hpp), buffer-only kernels need no descriptor sets
+// kernels enable GL_EXT_buffer_reference before including this header
+// usage: BUFFER_POINTER Pixels { uint values[]; };  KERNEL_ARGS Args { Pixels uPixels; uint uCount; };
+#ifndef VKC_POINTERS_GLSL
+#define VKC_POINTERS_GLSL
+
+// std430 blocks of scalar alignment, pointers may address any 4 byte aligned offset of a buffer
+#define BUFFER_POINTER layout(buffer_reference, std430, buffer_reference_align = 4) buffer
+
+// arguments are push constants only (pointers are 8 byte aligned, host structs use alignas(8) DevicePointer members)
+#define KERNEL_ARGS layout(push_constant, std430) uniform
+
+#endif
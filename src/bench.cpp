@@ -0,0 +1,319 @@
+#include "bench.hpp"
+#include "descriptor_allocator.hpp"
+#include "descriptor_buffer.hpp"
+#include <cassert>
+#include <iostream>
+
+// empty compute kernel: "layout(local_size_x = 1) in; void main() {}"
+static const uint32_t emptyKernelSpirv[] = {
+    0x07230203, 0x00010000, 0x00000000, 0x00000005, 0x00000000,
+    0x00020011, 0x00000001,                                     // OpCapability Shader
+    0x0003000E, 0x00000000, 0x00000001,                         // OpMemoryModel Logical GLSL450
+    0x0005000F, 0x00000005, 0x00000001, 0x6E69616D, 0x00000000, // OpEntryPoint GLCompute %1 "main"
+    0x00060010, 0x00000001, 0x00000011, 1, 1, 1,                // OpExecutionMode %1 LocalSize 1 1 1
+    0x00020013, 0x00000002,                                     // %2 = OpTypeVoid
+    0x00030021, 0x00000003, 0x00000002,                         // %3 = OpTypeFunction %2
+    0x00050036, 0x00000002, 0x00000001, 0x00000000, 0x00000003, // %1 = OpFunction %2 None %3
+    0x000200F8, 0x00000004,                                     // %4 = OpLabel
+    0x000100FD,                                                 // OpReturn
+    0x00010038                                                  // OpFunctionEnd
+};
+
+// empty kernel handles
+struct EmptyKernel {
+    VkShaderModule shaderModule{};
+    VkPipelineLayout pipelineLayout{};
+    VkPipeline pipeline{};
+};
+
+// create empty kernel pipeline (no descriptor sets, so dispatch needs no bindings)
+static EmptyKernel CreateEmptyKernel(VkDevice device) {
+    EmptyKernel emptyKernel{};
+    VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+    shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    shaderModuleCreateInfo.codeSize = sizeof(emptyKernelSpirv);
+    shaderModuleCreateInfo.pCode = emptyKernelSpirv;
+    vkCreateShaderModule(device, &shaderModuleCreateInfo, VK_NULL_HANDLE, &emptyKernel.shaderModule);
+    assert(emptyKernel.shaderModule);
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, VK_NULL_HANDLE, &emptyKernel.pipelineLayout);
+    assert(emptyKernel.pipelineLayout);
+    VkComputePipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineCreateInfo.stage.module = emptyKernel.shaderModule;
+    pipelineCreateInfo.stage.pName = "main";
+    pipelineCreateInfo.layout = emptyKernel.pipelineLayout;
+    vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, VK_NULL_HANDLE, &emptyKernel.pipeline);
+    assert(emptyKernel.pipeline);
+    return emptyKernel;
+}
+
+// destroy empty kernel pipeline
+static void DestroyEmptyKernel(VkDevice device, const EmptyKernel& emptyKernel) {
+    vkDestroyPipeline(device, emptyKernel.pipeline, VK_NULL_HANDLE);
+    vkDestroyPipelineLayout(device, emptyKernel.pipelineLayout, VK_NULL_HANDLE);
+    vkDestroyShaderModule(device, emptyKernel.shaderModule, VK_NULL_HANDLE);
+}
+
+// measure dispatch recording and submit overhead with an empty kernel
+OverheadReport MeasureDispatchSubmitOverhead(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, uint32_t dispatchCount, uint32_t submitCount) {
+    OverheadReport report{};
+
+    // empty kernel pipeline
+    EmptyKernel emptyKernel = CreateEmptyKernel(device);
+    VkPipeline pipeline = emptyKernel.pipeline;
+
+    // command pool, command buffer and fence
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    VkCommandPool commandPool{};
+    vkCreateCommandPool(device, &commandPoolCreateInfo, VK_NULL_HANDLE, &commandPool);
+    assert(commandPool);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = commandPool;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer{};
+    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+    assert(commandBuffer);
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence{};
+    vkCreateFence(device, &fenceCreateInfo, VK_NULL_HANDLE, &fence);
+    assert(fence);
+
+    // record dispatches
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+    Stopwatch recordStopwatch{};
+    for (uint32_t i = 0; i < dispatchCount; i++) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+    }
+    report.recordDispatchNs = recordStopwatch.ElapsedNs() / dispatchCount;
+    vkEndCommandBuffer(commandBuffer);
+
+    // submit recorded command buffer: call cost and full roundtrip
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    double submitNs{};
+    Stopwatch roundtripStopwatch{};
+    for (uint32_t i = 0; i < submitCount; i++) {
+        Stopwatch submitStopwatch{};
+        vkQueueSubmit(queue, 1, &submitInfo, fence);
+        submitNs += submitStopwatch.ElapsedNs();
+        vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+        vkResetFences(device, 1, &fence);
+    }
+    report.roundtripNs = roundtripStopwatch.ElapsedNs() / submitCount;
+    report.submitNs = submitNs / submitCount;
+
+    // destroy handles
+    vkDestroyFence(device, fence, VK_NULL_HANDLE);
+    vkDestroyCommandPool(device, commandPool, VK_NULL_HANDLE);
+    DestroyEmptyKernel(device, emptyKernel);
+    return report;
+}
+
+// print overhead report
+void PrintOverheadReport(const char* name, const OverheadReport& report) {
+    std::cout << "Overhead [" << name << "]:";
+    std::cout << " record dispatch " << report.recordDispatchNs << " ns";
+    std::cout << ", submit " << report.submitNs / 1000.0 << " us";
+    std::cout << ", submit+wait " << report.roundtripNs / 1000.0 << " us" << std::endl;
+}
+
+// measure command recording cost through loader trampolines and device dispatch table
+RecordingCostReport MeasureRecordingCost(VkInstance instance, VkDevice device, uint32_t queueFamilyIndex, uint32_t commandCount) {
+    RecordingCostReport report{};
+    EmptyKernel emptyKernel = CreateEmptyKernel(device);
+
+    // loader exports: instance level pointers of device commands point to dispatch trampolines
+    auto trampolineCmdBindPipeline = (PFN_vkCmdBindPipeline)vkGetInstanceProcAddr(instance, "vkCmdBindPipeline");
+    auto trampolineCmdDispatch = (PFN_vkCmdDispatch)vkGetInstanceProcAddr(instance, "vkCmdDispatch");
+    assert(trampolineCmdBindPipeline && trampolineCmdDispatch);
+
+    // command pool and command buffer
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    VkCommandPool commandPool{};
+    vkCreateCommandPool(device, &commandPoolCreateInfo, VK_NULL_HANDLE, &commandPool);
+    assert(commandPool);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = commandPool;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer{};
+    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+    assert(commandBuffer);
+
+    // record same command stream with both function sets (bind + dispatch is two commands)
+    auto measure = [&](PFN_vkCmdBindPipeline fnCmdBindPipeline, PFN_vkCmdDispatch fnCmdDispatch) {
+        VkCommandBufferBeginInfo commandBufferBeginInfo{};
+        commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        vkResetCommandBuffer(commandBuffer, 0);
+        vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+        Stopwatch stopwatch{};
+        for (uint32_t i = 0; i < commandCount / 2; i++) {
+            fnCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, emptyKernel.pipeline);
+            fnCmdDispatch(commandBuffer, 1, 1, 1);
+        }
+        const double elapsedNs = stopwatch.ElapsedNs();
+        vkEndCommandBuffer(commandBuffer);
+        return elapsedNs / (commandCount / 2 * 2);
+    };
+    measure(vkCmdBindPipeline, vkCmdDispatch); // warm up
+    report.trampolineNs = measure(trampolineCmdBindPipeline, trampolineCmdDispatch);
+    report.directNs = measure(vkCmdBindPipeline, vkCmdDispatch);
+
+    // destroy handles
+    vkDestroyCommandPool(device, commandPool, VK_NULL_HANDLE);
+    DestroyEmptyKernel(device, emptyKernel);
+    return report;
+}
+
+// print recording cost report
+void PrintRecordingCostReport(const RecordingCostReport& report) {
+    std::cout << "Recording cost per command: loader trampoline " << report.trampolineNs << " ns";
+    std::cout << ", device dispatch table " << report.directNs << " ns" << std::endl;
+}
+
+// measure descriptor set update cost
+DescriptorUpdateReport MeasureDescriptorUpdateCost(VkDevice device, VkDescriptorSet descriptorSet, VkDescriptorUpdateTemplate updateTemplate,
+    DescriptorSetData& data, uint32_t updateCount) {
+    DescriptorUpdateReport report{};
+    auto measure = [&](auto update) {
+        update(); // warm up
+        Stopwatch stopwatch{};
+        for (uint32_t i = 0; i < updateCount; i++) update();
+        return stopwatch.ElapsedNs() / updateCount;
+    };
+    report.writeNs = measure([&]() { data.Write(device, descriptorSet); });
+    report.templateNs = measure([&]() { data.Update(device, descriptorSet, updateTemplate); });
+    return report;
+}
+
+// print descriptor update report
+void PrintDescriptorUpdateReport(const char* name, const DescriptorUpdateReport& report) {
+    std::cout << "Descriptor update per dispatch (" << name << "): writes " << report.writeNs << " ns";
+    std::cout << ", update template " << report.templateNs << " ns" << std::endl;
+}
+
+// measure descriptor backend cost
+DescriptorBackendReport MeasureDescriptorBackendCost(VkDevice device, DescriptorAllocator& descriptorAllocator, VkDescriptorSetLayout poolSetLayout,
+    VkDescriptorUpdateTemplate updateTemplate, DescriptorBufferRing& descriptorBufferRing, VkDescriptorSetLayout bufferSetLayout,
+    const DescriptorSetData& data, uint32_t frameCount, uint32_t setsPerFrame) {
+    DescriptorBackendReport report{};
+    auto measure = [&](auto beginFrame, auto dispatch) {
+        Stopwatch stopwatch{};
+        for (uint32_t frame = 0; frame < frameCount; frame++) {
+            beginFrame();
+            for (uint32_t i = 0; i < setsPerFrame; i++) dispatch();
+        }
+        return stopwatch.ElapsedNs() / ((double)frameCount * setsPerFrame);
+    };
+    report.poolNs = measure([&]() { descriptorAllocator.BeginFrame(); }, [&]() {
+        VkDescriptorSet descriptorSet = descriptorAllocator.Allocate(poolSetLayout);
+        assert(descriptorSet);
+        data.Update(device, descriptorSet, updateTemplate);
+    });
+    report.descriptorBufferNs = measure([&]() { descriptorBufferRing.NextFrame(); }, [&]() {
+        DescriptorBufferSet descriptorSet = descriptorBufferRing.Allocate(bufferSetLayout);
+        assert(descriptorSet);
+        descriptorBufferRing.Write(descriptorSet, data);
+    });
+    return report;
+}
+
+// print descriptor backend report
+void PrintDescriptorBackendReport(const char* name, const DescriptorBackendReport& report) {
+    std::cout << "Descriptor backend per dispatch (" << name << "): pools " << report.poolNs << " ns";
+    std::cout << ", descriptor buffer " << report.descriptorBufferNs << " ns" << std::endl;
+}
+
+// measure gpu time of recorded work with timestamp queries
+double MeasureGpuTimeMs(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod, const std::function<void(VkCommandBuffer)>& record, uint32_t iterations,
+    const std::function<bool(VkCommandBuffer)>& setup) {
+    if (timestampPeriod <= 0.0f || iterations == 0) return -1.0;
+
+    // timestamp query pool
+    VkQueryPoolCreateInfo queryPoolCreateInfo{};
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = 2;
+    VkQueryPool queryPool{};
+    vkCreateQueryPool(device, &queryPoolCreateInfo, VK_NULL_HANDLE, &queryPool);
+    assert(queryPool);
+
+    // command pool, command buffer and fence
+    VkCommandPoolCreateInfo commandPoolCreateInfo{};
+    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    commandPoolCreateInfo.queueFamilyIndex = queueFamilyIndex;
+    VkCommandPool commandPool{};
+    vkCreateCommandPool(device, &commandPoolCreateInfo, VK_NULL_HANDLE, &commandPool);
+    assert(commandPool);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    commandBufferAllocateInfo.commandPool = commandPool;
+    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    commandBufferAllocateInfo.commandBufferCount = 1;
+    VkCommandBuffer commandBuffer{};
+    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+    assert(commandBuffer);
+    VkFenceCreateInfo fenceCreateInfo{};
+    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    VkFence fence{};
+    vkCreateFence(device, &fenceCreateInfo, VK_NULL_HANDLE, &fence);
+    assert(fence);
+
+    // record work between two timestamps, iterations are serialized by compute barriers
+    VkCommandBufferBeginInfo commandBufferBeginInfo{};
+    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+    // resources bound once (descriptor sets and push constants stay bound across pipelines of compatible layout)
+    const bool setupRecorded = !setup || setup(commandBuffer);
+    vkCmdResetQueryPool(commandBuffer, queryPool, 0, 2);
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 0);
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    for (uint32_t i = 0; setupRecorded && i < iterations; i++) {
+        if (i > 0) vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+        record(commandBuffer);
+    }
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 1);
+    vkEndCommandBuffer(commandBuffer);
+
+    // submit and wait
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+    vkQueueSubmit(queue, 1, &submitInfo, fence);
+    vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+
+    // read timestamps
+    uint64_t timestamps[2]{};
+    VkResult result = vkGetQueryPoolResults(device, queryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    double gpuMs = result == VK_SUCCESS && setupRecorded ? (double)(timestamps[1] - timestamps[0]) * timestampPeriod * 1e-6 / iterations : -1.0;
+
+    // destroy handles
+    vkDestroyFence(device, fence, VK_NULL_HANDLE);
+    vkDestroyCommandPool(device, commandPool, VK_NULL_HANDLE);
+    vkDestroyQueryPool(device, queryPool, VK_NULL_HANDLE);
+    return gpuMs;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include "vulkan_loader.hpp"
+#include "descriptor_update.hpp"
+
+class DescriptorAllocator;
+class DescriptorBufferRing;
+
+// cpu stopwatch
+struct Stopwatch {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // elapsed time in nanoseconds
+    double ElapsedNs() const { return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count(); }
+    // elapsed time in milliseconds
+    double ElapsedMs() const { return ElapsedNs() * 1e-6; }
+};
+
+// dispatch and submit cpu overhead
+struct OverheadReport {
+    double recordDispatchNs{}; // vkCmdBindPipeline + vkCmdDispatch recording per dispatch
+    double submitNs{};         // vkQueueSubmit call per submit
+    double roundtripNs{};      // vkQueueSubmit + fence wait per submit
+};
+
+// measure dispatch recording and submit overhead with an empty kernel
+OverheadReport MeasureDispatchSubmitOverhead(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, uint32_t dispatchCount, uint32_t submitCount);
+
+// print overhead report
+void PrintOverheadReport(const char* name, const OverheadReport& report);
+
+// command recording cost per command
+struct RecordingCostReport {
+    double trampolineNs{}; // functions from vkGetInstanceProcAddr (loader trampolines)
+    double directNs{};     // functions from vkGetDeviceProcAddr (device dispatch table)
+};
+
+// measure command recording cost through loader trampolines and device dispatch table
+RecordingCostReport MeasureRecordingCost(VkInstance instance, VkDevice device, uint32_t queueFamilyIndex, uint32_t commandCount);
+
+// print recording cost report
+void PrintRecordingCostReport(const RecordingCostReport& report);
+
+// descriptor set update cpu cost per dispatch
+struct DescriptorUpdateReport {
+    double writeNs{};    // VkWriteDescriptorSet array built and written (vkUpdateDescriptorSets)
+    double templateNs{}; // packed data written with one vkUpdateDescriptorSetWithTemplate call
+};
+
+// measure descriptor set update cost of set data through writes and through update template (set must not be in use)
+DescriptorUpdateReport MeasureDescriptorUpdateCost(VkDevice device, VkDescriptorSet descriptorSet, VkDescriptorUpdateTemplate updateTemplate,
+    DescriptorSetData& data, uint32_t updateCount);
+
+// print descriptor update report
+void PrintDescriptorUpdateReport(const char* name, const DescriptorUpdateReport& report);
+
+// descriptor backend cpu cost per dispatch: set allocation and descriptor writes of same set data
+struct DescriptorBackendReport {
+    double poolNs{};             // set from per frame pools, written with update template
+    double descriptorBufferNs{}; // set suballocated from descriptor buffer ring, written with vkGetDescriptorEXT
+};
+
+// measure descriptor backends over frames of setsPerFrame dispatches (pools and ring regions are recycled per frame,
+// nothing may be in flight), pool set layout and template are classic, buffer set layout is descriptor buffer layout of same bindings
+DescriptorBackendReport MeasureDescriptorBackendCost(VkDevice device, DescriptorAllocator& descriptorAllocator, VkDescriptorSetLayout poolSetLayout,
+    VkDescriptorUpdateTemplate updateTemplate, DescriptorBufferRing& descriptorBufferRing, VkDescriptorSetLayout bufferSetLayout,
+    const DescriptorSetData& data, uint32_t frameCount, uint32_t setsPerFrame);
+
+// print descriptor backend report
+void PrintDescriptorBackendReport(const char* name, const DescriptorBackendReport& report);
+
+// measure gpu time of recorded work with timestamp queries, record callback is run once per iteration
+// setup callback (optional) is run once before first timestamp, binds resources shared by iterations, false skips measurement
+// timestamp period is in nanoseconds per tick (zero when queue family has no timestamp support)
+// returns average milliseconds per iteration or negative value when timestamps are not supported or setup failed
+double MeasureGpuTimeMs(VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod, const std::function<void(VkCommandBuffer)>& record, uint32_t iterations,
+    const std::function<bool(VkCommandBuffer)>& setup = {});
@@ -0,0 +1,170 @@
+#include "bindless_descriptors.hpp"
+#include "layout_cache.hpp"
+#include <iostream>
+#include <algorithm>
+
+// allocate slot
+uint32_t SlotAllocator::Allocate() {
+    uint32_t slot = UINT32_MAX;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else if (nextSlot < capacity) {
+        slot = nextSlot++;
+    }
+    if (slot != UINT32_MAX) usedCount++;
+    return slot;
+}
+
+// free slot in frame
+void SlotAllocator::Free(uint32_t slot, uint64_t frame) {
+    if (slot >= nextSlot) return;
+    pendingSlots.push_back({ slot, frame });
+    usedCount--;
+}
+
+// return slots freed up to completed frame to free list
+void SlotAllocator::Reclaim(uint64_t completedFrame) {
+    auto reusable = std::stable_partition(pendingSlots.begin(), pendingSlots.end(), [&](const PendingSlot& pending) { return pending.frame > completedFrame; });
+    for (auto pending = reusable; pending != pendingSlots.end(); ++pending) freeSlots.push_back(pending->slot);
+    pendingSlots.erase(reusable, pendingSlots.end());
+}
+
+// check device supports bindless descriptors
+bool SupportsBindlessDescriptors(const DeviceCapabilities& capabilities) {
+    return capabilities.runtimeDescriptorArray && capabilities.descriptorBindingPartiallyBound && capabilities.descriptorBindingUpdateUnusedWhilePending &&
+        capabilities.descriptorBindingStorageImageUpdateAfterBind && capabilities.descriptorBindingStorageBufferUpdateAfterBind &&
+        capabilities.maxUpdateAfterBindStorageImages && capabilities.maxUpdateAfterBindStorageBuffers;
+}
+
+BindlessDescriptors::BindlessDescriptors(VkDevice device, const DeviceCapabilities& capabilities, uint32_t framesInFlight, uint32_t imageCapacity, uint32_t bufferCapacity) :
+    device(device), framesInFlight(std::max(1u, framesInFlight)),
+    imageSlots(std::min(imageCapacity, capabilities.maxUpdateAfterBindStorageImages)), bufferSlots(std::min(bufferCapacity, capabilities.maxUpdateAfterBindStorageBuffers)) {
+    if (!SupportsBindlessDescriptors(capabilities)) return;
+
+    // bindings: storage image array (binding 0) and storage buffer array (binding 1)
+    const VkDescriptorSetLayoutBinding bindings[2]{
+        { 0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, imageSlots.GetCapacity(), VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE },
+        { 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferSlots.GetCapacity(), VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE }
+    };
+    // unused slots are never accessed, slots not used by pending dispatches are written while they execute
+    const VkDescriptorBindingFlags bindingFlags[2]{
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT
+    };
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCreateInfo{};
+    bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsCreateInfo.pNext = VK_NULL_HANDLE;
+    bindingFlagsCreateInfo.bindingCount = 2;
+    bindingFlagsCreateInfo.pBindingFlags = bindingFlags;
+    // descriptor set layout create info
+    VkDescriptorSetLayoutCreateInfo descSetLayoutCreateInfo{};
+    descSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descSetLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+    descSetLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    descSetLayoutCreateInfo.bindingCount = 2;
+    descSetLayoutCreateInfo.pBindings = bindings;
+    vkCreateDescriptorSetLayout(device, &descSetLayoutCreateInfo, VK_NULL_HANDLE, &setLayout);
+    if (!setLayout) return;
+
+    // descriptor pool create info (one set for lifetime of device)
+    const VkDescriptorPoolSize poolSizes[2]{
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, imageSlots.GetCapacity() },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferSlots.GetCapacity() }
+    };
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.pNext = VK_NULL_HANDLE;
+    descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    descriptorPoolCreateInfo.maxSets = 1;
+    descriptorPoolCreateInfo.poolSizeCount = 2;
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes;
+    vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, VK_NULL_HANDLE, &descriptorPool);
+    if (!descriptorPool) return;
+
+    // descriptor set allocate info
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.pNext = VK_NULL_HANDLE;
+    descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &setLayout;
+    vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &descriptorSet);
+}
+
+BindlessDescriptors::~BindlessDescriptors() {
+    if (descriptorPool) vkDestroyDescriptorPool(device, descriptorPool, VK_NULL_HANDLE);
+    if (setLayout) vkDestroyDescriptorSetLayout(device, setLayout, VK_NULL_HANDLE);
+}
+
+// write descriptor of slot (mutex is held)
+void BindlessDescriptors::Write(uint32_t binding, uint32_t slot, VkDescriptorType descriptorType, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo) {
+    VkWriteDescriptorSet writeDescriptorSet{};
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.pNext = VK_NULL_HANDLE;
+    writeDescriptorSet.dstSet = descriptorSet;
+    writeDescriptorSet.dstBinding = binding;
+    writeDescriptorSet.dstArrayElement = slot;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.descriptorType = descriptorType;
+    writeDescriptorSet.pImageInfo = imageInfo;
+    writeDescriptorSet.pBufferInfo = bufferInfo;
+    writeDescriptorSet.pTexelBufferView = VK_NULL_HANDLE;
+    vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, VK_NULL_HANDLE);
+}
+
+// add storage image
+uint32_t BindlessDescriptors::AddStorageImage(VkImageView imageView, VkImageLayout imageLayout) {
+    if (!descriptorSet) return UINT32_MAX;
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t slot = imageSlots.Allocate();
+    if (slot == UINT32_MAX) return slot;
+    const VkDescriptorImageInfo imageInfo{ VK_NULL_HANDLE, imageView, imageLayout };
+    Write(0, slot, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, &imageInfo, VK_NULL_HANDLE);
+    return slot;
+}
+
+// add storage buffer
+uint32_t BindlessDescriptors::AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
+    if (!descriptorSet) return UINT32_MAX;
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t slot = bufferSlots.Allocate();
+    if (slot == UINT32_MAX) return slot;
+    const VkDescriptorBufferInfo bufferInfo{ buffer, offset, range };
+    Write(1, slot, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_NULL_HANDLE, &bufferInfo);
+    return slot;
+}
+
+// remove resource (descriptor stays valid until slot is reused)
+void BindlessDescriptors::RemoveStorageImage(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    imageSlots.Free(slot, frame);
+}
+
+void BindlessDescriptors::RemoveStorageBuffer(uint32_t slot) {
+    std::lock_guard<std::mutex> lock(mutex);
+    bufferSlots.Free(slot, frame);
+}
+
+// begin next frame, slots removed framesInFlight frames ago are reusable
+uint64_t BindlessDescriptors::BeginFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    frame++;
+    if (frame >= framesInFlight) {
+        imageSlots.Reclaim(frame - framesInFlight);
+        bufferSlots.Reclaim(frame - framesInFlight);
+    }
+    return frame;
+}
+
+// bind set at BindlessSet
+void BindlessDescriptors::Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) const {
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, BindlessSet, 1, &descriptorSet, 0, VK_NULL_HANDLE);
+}
+
+// print slot usage
+void BindlessDescriptors::PrintReport() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::cout << "Bindless descriptors: storage images " << imageSlots.GetUsedCount() << "/" << imageSlots.GetCapacity();
+    std::cout << ", storage buffers " << bufferSlots.GetUsedCount() << "/" << bufferSlots.GetCapacity() << std::endl;
+}
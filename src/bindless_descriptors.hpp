@@ -0,0 +1,77 @@
+#pragma once
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include "vulkan_loader.hpp"
+#include "capabilities.hpp"
+
+// slot allocator of bindless descriptor array: free list of indices,
+// freed slots are reused only after frame they were freed in completed (pending dispatches may still index them)
+class SlotAllocator {
+public:
+    explicit SlotAllocator(uint32_t capacity = 0) : capacity(capacity) {}
+    // allocate slot, UINT32_MAX when array is full
+    uint32_t Allocate();
+    // free slot in frame
+    void Free(uint32_t slot, uint64_t frame);
+    // return slots freed in frames up to completed frame to free list
+    void Reclaim(uint64_t completedFrame);
+    // get count of allocated slots and array size
+    uint32_t GetUsedCount() const { return usedCount; }
+    uint32_t GetCapacity() const { return capacity; }
+private:
+    struct PendingSlot {
+        uint32_t slot{};
+        uint64_t frame{};
+    };
+    uint32_t capacity{};
+    uint32_t nextSlot{};                     // slots from here on were never allocated
+    uint32_t usedCount{};
+    std::vector<uint32_t> freeSlots{};
+    std::vector<PendingSlot> pendingSlots{}; // freed, not yet reusable
+};
+
+// check device supports bindless descriptors (descriptor indexing of storage images and buffers, core 1.2)
+bool SupportsBindlessDescriptors(const DeviceCapabilities& capabilities);
+
+// bindless descriptor set (BindlessSet of layout_cache.hpp, shaders/include/bindless.glsl): runtime sized arrays of
+// storage images (binding 0) and storage buffers (binding 1), partially bound and updated after bind,
+// kernels index resources by slot so a batch of images needs one set bind and one dispatch (thread safe)
+class BindlessDescriptors {
+public:
+    // array sizes are clamped to update after bind limits of device
+    BindlessDescriptors(VkDevice device, const DeviceCapabilities& capabilities, uint32_t framesInFlight, uint32_t imageCapacity = 16384, uint32_t bufferCapacity = 1024);
+    ~BindlessDescriptors();
+    BindlessDescriptors(const BindlessDescriptors&) = delete;
+    BindlessDescriptors& operator=(const BindlessDescriptors&) = delete;
+    // check set was created
+    explicit operator bool() const { return descriptorSet != VK_NULL_HANDLE; }
+    // get set layout (kernel layouts use it for BindlessSet)
+    VkDescriptorSetLayout GetSetLayout() const { return setLayout; }
+    // get storage image array size (clamped to update after bind limit)
+    uint32_t GetStorageImageCapacity() const { return imageSlots.GetCapacity(); }
+    // add storage image, returns slot, UINT32_MAX when array is full
+    uint32_t AddStorageImage(VkImageView imageView, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_GENERAL);
+    // add storage buffer, returns slot, UINT32_MAX when array is full
+    uint32_t AddStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+    // remove resource, slot is reused after frames in flight
+    void RemoveStorageImage(uint32_t slot);
+    void RemoveStorageBuffer(uint32_t slot);
+    // begin next frame, returns frame number (caller waited completion of frame submitted framesInFlight frames ago)
+    uint64_t BeginFrame();
+    // bind set at BindlessSet of pipeline layout
+    void Bind(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout) const;
+    // print slot usage
+    void PrintReport();
+private:
+    void Write(uint32_t binding, uint32_t slot, VkDescriptorType descriptorType, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo);
+    VkDevice device{};
+    uint32_t framesInFlight{};
+    VkDescriptorSetLayout setLayout{};
+    VkDescriptorPool descriptorPool{};
+    VkDescriptorSet descriptorSet{};
+    std::mutex mutex{};                      // slot allocators and set writes
+    uint64_t frame{};
+    SlotAllocator imageSlots{};
+    SlotAllocator bufferSlots{};
+};
@@ -0,0 +1,203 @@
+#include "capabilities.hpp"
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+// set sTypes and link structures supported by device api version
+void* DeviceFeatureChain::Link(uint32_t apiVersion) {
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    vulkan11.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+    vulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan13.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    features2.pNext = VK_NULL_HANDLE;
+    vulkan11.pNext = VK_NULL_HANDLE;
+    vulkan12.pNext = VK_NULL_HANDLE;
+    vulkan13.pNext = VK_NULL_HANDLE;
+    shaderObject.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+    shaderObject.pNext = VK_NULL_HANDLE;
+    descriptorBuffer.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+    descriptorBuffer.pNext = VK_NULL_HANDLE;
+    if (apiVersion >= VK_API_VERSION_1_2) features2.pNext = &vulkan11, vulkan11.pNext = &vulkan12;
+    if (apiVersion >= VK_API_VERSION_1_3) vulkan12.pNext = &vulkan13;
+    return &features2;
+}
+
+// link extension feature structure after chain head
+void DeviceFeatureChain::LinkExtension(void* feature) {
+    ((VkBaseOutStructure*)feature)->pNext = (VkBaseOutStructure*)features2.pNext;
+    features2.pNext = feature;
+}
+
+// enumerate device extensions
+std::vector<VkExtensionProperties> EnumerateDeviceExtensions(VkPhysicalDevice physicalDevice) {
+    uint32_t extensionCount{};
+    vkEnumerateDeviceExtensionProperties(physicalDevice, VK_NULL_HANDLE, &extensionCount, VK_NULL_HANDLE);
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, VK_NULL_HANDLE, &extensionCount, extensions.data());
+    return extensions;
+}
+
+// check extension is in list
+bool HasExtension(const std::vector<VkExtensionProperties>& extensions, const char* extensionName) {
+    return std::any_of(extensions.begin(), extensions.end(), [&](const auto& extension) { return strcmp(extension.extensionName, extensionName) == 0; });
+}
+
+// query supported features and extensions, enable what is present
+DeviceCapabilities NegotiateDeviceCapabilities(VkPhysicalDevice physicalDevice, DeviceFeatureChain& enabledFeatures, std::vector<const char*>& enabledExtensions) {
+    DeviceCapabilities capabilities{};
+
+    // device api version (1.2/1.3 structures are only valid on devices supporting them)
+    VkPhysicalDeviceSubgroupProperties subgroupProperties{};
+    subgroupProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+    VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+    vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+    VkPhysicalDeviceVulkan13Properties vulkan13Properties{};
+    vulkan13Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES;
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    capabilities.apiVersion = std::min<uint32_t>(properties.apiVersion, VK_API_VERSION_1_3);
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &subgroupProperties;
+    if (capabilities.apiVersion >= VK_API_VERSION_1_2) subgroupProperties.pNext = &vulkan12Properties;
+    if (capabilities.apiVersion >= VK_API_VERSION_1_3) vulkan12Properties.pNext = &vulkan13Properties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+    capabilities.subgroupSize = subgroupProperties.subgroupSize;
+    capabilities.minSubgroupSize = vulkan13Properties.minSubgroupSize ? vulkan13Properties.minSubgroupSize : subgroupProperties.subgroupSize;
+    capabilities.maxSubgroupSize = vulkan13Properties.maxSubgroupSize ? vulkan13Properties.maxSubgroupSize : subgroupProperties.subgroupSize;
+    capabilities.maxPushConstantsSize = properties.limits.maxPushConstantsSize;
+    capabilities.maxUpdateAfterBindStorageImages = std::min(vulkan12Properties.maxPerStageDescriptorUpdateAfterBindStorageImages, vulkan12Properties.maxDescriptorSetUpdateAfterBindStorageImages);
+    capabilities.maxUpdateAfterBindStorageBuffers = std::min(vulkan12Properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers, vulkan12Properties.maxDescriptorSetUpdateAfterBindStorageBuffers);
+
+    // supported features
+    DeviceFeatureChain supported{};
+    vkGetPhysicalDeviceFeatures2(physicalDevice, (VkPhysicalDeviceFeatures2*)supported.Link(capabilities.apiVersion));
+    enabledFeatures = DeviceFeatureChain{};
+    enabledFeatures.Link(capabilities.apiVersion);
+
+    // enable feature if supported and store it in capabilities
+    #define ENABLE_FEATURE(chain, feature) \
+        capabilities.feature = supported.chain.feature == VK_TRUE; \
+        enabledFeatures.chain.feature = supported.chain.feature;
+    ENABLE_FEATURE(features2.features, shaderInt16);
+    ENABLE_FEATURE(features2.features, shaderInt64);
+    ENABLE_FEATURE(vulkan11, storageBuffer16BitAccess);
+    ENABLE_FEATURE(vulkan12, timelineSemaphore);
+    ENABLE_FEATURE(vulkan12, bufferDeviceAddress);
+    ENABLE_FEATURE(vulkan12, shaderFloat16);
+    ENABLE_FEATURE(vulkan12, shaderInt8);
+    ENABLE_FEATURE(vulkan12, storageBuffer8BitAccess);
+    ENABLE_FEATURE(vulkan12, runtimeDescriptorArray);
+    ENABLE_FEATURE(vulkan12, descriptorBindingPartiallyBound);
+    ENABLE_FEATURE(vulkan12, descriptorBindingUpdateUnusedWhilePending);
+    ENABLE_FEATURE(vulkan12, descriptorBindingStorageImageUpdateAfterBind);
+    ENABLE_FEATURE(vulkan12, descriptorBindingStorageBufferUpdateAfterBind);
+    ENABLE_FEATURE(vulkan13, synchronization2);
+    ENABLE_FEATURE(vulkan13, subgroupSizeControl);
+    ENABLE_FEATURE(vulkan13, computeFullSubgroups);
+    ENABLE_FEATURE(vulkan13, maintenance4);
+    #undef ENABLE_FEATURE
+
+    // optional extensions
+    std::vector<VkExtensionProperties> extensions = EnumerateDeviceExtensions(physicalDevice);
+    auto enableExtension = [&](const char* extensionName) {
+        if (!HasExtension(extensions, extensionName)) return false;
+        enabledExtensions.push_back(extensionName);
+        return true;
+    };
+    capabilities.rayTracingPipeline =
+        HasExtension(extensions, VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME) &&
+        HasExtension(extensions, VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME) &&
+        HasExtension(extensions, VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+    if (capabilities.rayTracingPipeline) {
+        enableExtension(VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME);
+        enableExtension(VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME);
+        enableExtension(VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME);
+    }
+    capabilities.pipelineCreationFeedback = capabilities.apiVersion >= VK_API_VERSION_1_3 || enableExtension(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME);
+
+    // shader objects: compute shaders created from driver binaries without pipelines (dynamic rendering dependency is core 1.3)
+    if (capabilities.apiVersion >= VK_API_VERSION_1_3 && HasExtension(extensions, VK_EXT_SHADER_OBJECT_EXTENSION_NAME)) {
+        VkPhysicalDeviceShaderObjectFeaturesEXT shaderObjectFeatures{};
+        shaderObjectFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &shaderObjectFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+        if (shaderObjectFeatures.shaderObject && enableExtension(VK_EXT_SHADER_OBJECT_EXTENSION_NAME)) {
+            capabilities.shaderObject = true;
+            enabledFeatures.shaderObject.shaderObject = VK_TRUE;
+            enabledFeatures.LinkExtension(&enabledFeatures.shaderObject);
+            VkPhysicalDeviceShaderObjectPropertiesEXT shaderObjectProperties{};
+            shaderObjectProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_PROPERTIES_EXT;
+            properties2.pNext = &shaderObjectProperties;
+            vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+            memcpy(capabilities.shaderBinaryUUID, shaderObjectProperties.shaderBinaryUUID, VK_UUID_SIZE);
+            capabilities.shaderBinaryVersion = shaderObjectProperties.shaderBinaryVersion;
+        }
+    }
+
+    // push descriptors: kernel resources recorded into command buffer without descriptor set allocation
+    if (enableExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
+        capabilities.pushDescriptor = true;
+        VkPhysicalDevicePushDescriptorPropertiesKHR pushDescriptorProperties{};
+        pushDescriptorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+        properties2.pNext = &pushDescriptorProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+        capabilities.maxPushDescriptors = pushDescriptorProperties.maxPushDescriptors;
+    }
+
+    // descriptor buffers: descriptors written into buffer memory and bound by offset, no pools and no descriptor sets
+    if (capabilities.apiVersion >= VK_API_VERSION_1_3 && capabilities.bufferDeviceAddress && HasExtension(extensions, VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) {
+        VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBufferFeatures{};
+        descriptorBufferFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features2.pNext = &descriptorBufferFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features2);
+        if (descriptorBufferFeatures.descriptorBuffer && enableExtension(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) {
+            capabilities.descriptorBuffer = true;
+            enabledFeatures.descriptorBuffer.descriptorBuffer = VK_TRUE;
+            enabledFeatures.LinkExtension(&enabledFeatures.descriptorBuffer);
+            capabilities.descriptorBufferProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+            properties2.pNext = &capabilities.descriptorBufferProperties;
+            vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+            capabilities.descriptorBufferProperties.pNext = VK_NULL_HANDLE;
+        }
+    }
+    return capabilities;
+}
+
+// print negotiated capabilities
+void PrintDeviceCapabilities(const DeviceCapabilities& capabilities) {
+    std::cout << "Device capabilities:";
+    std::cout << " api " << VK_API_VERSION_MAJOR(capabilities.apiVersion) << "." << VK_API_VERSION_MINOR(capabilities.apiVersion);
+    std::cout << ", subgroup " << capabilities.subgroupSize << " [" << capabilities.minSubgroupSize << ".." << capabilities.maxSubgroupSize << "]";
+    std::cout << ", push constants " << capabilities.maxPushConstantsSize << std::endl;
+    #define PRINT_CAPABILITY(name) if (capabilities.name) std::cout << " " #name;
+    std::cout << " ";
+    PRINT_CAPABILITY(shaderInt16);
+    PRINT_CAPABILITY(shaderInt64);
+    PRINT_CAPABILITY(storageBuffer16BitAccess);
+    PRINT_CAPABILITY(timelineSemaphore);
+    PRINT_CAPABILITY(bufferDeviceAddress);
+    PRINT_CAPABILITY(shaderFloat16);
+    PRINT_CAPABILITY(shaderInt8);
+    PRINT_CAPABILITY(storageBuffer8BitAccess);
+    PRINT_CAPABILITY(runtimeDescriptorArray);
+    PRINT_CAPABILITY(descriptorBindingPartiallyBound);
+    PRINT_CAPABILITY(descriptorBindingUpdateUnusedWhilePending);
+    PRINT_CAPABILITY(descriptorBindingStorageImageUpdateAfterBind);
+    PRINT_CAPABILITY(descriptorBindingStorageBufferUpdateAfterBind);
+    PRINT_CAPABILITY(synchronization2);
+    PRINT_CAPABILITY(subgroupSizeControl);
+    PRINT_CAPABILITY(computeFullSubgroups);
+    PRINT_CAPABILITY(maintenance4);
+    PRINT_CAPABILITY(rayTracingPipeline);
+    PRINT_CAPABILITY(pipelineCreationFeedback);
+    PRINT_CAPABILITY(shaderObject);
+    PRINT_CAPABILITY(pushDescriptor);
+    PRINT_CAPABILITY(descriptorBuffer);
+    #undef PRINT_CAPABILITY
+    std::cout << std::endl;
+}
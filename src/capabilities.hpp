@@ -0,0 +1,73 @@
+#pragma once
+#include <vector>
+#include "vulkan_loader.hpp"
+
+// device feature structure chain (core 1.0 - 1.3 features, extension features are linked when extension is enabled)
+struct DeviceFeatureChain {
+    VkPhysicalDeviceFeatures2 features2{};
+    VkPhysicalDeviceVulkan11Features vulkan11{};
+    VkPhysicalDeviceVulkan12Features vulkan12{};
+    VkPhysicalDeviceVulkan13Features vulkan13{};
+    VkPhysicalDeviceShaderObjectFeaturesEXT shaderObject{};
+    VkPhysicalDeviceDescriptorBufferFeaturesEXT descriptorBuffer{};
+    // set sTypes and link structures supported by device api version, returns chain head
+    void* Link(uint32_t apiVersion);
+    // link extension feature structure after chain head
+    void LinkExtension(void* feature);
+};
+
+// negotiated device capabilities, kernels use it to select fast paths at runtime
+struct DeviceCapabilities {
+    uint32_t apiVersion{};
+    // vulkan 1.0 features
+    bool shaderInt16{};
+    bool shaderInt64{};
+    // vulkan 1.1 features
+    bool storageBuffer16BitAccess{};
+    // vulkan 1.2 features
+    bool timelineSemaphore{};
+    bool bufferDeviceAddress{};
+    bool shaderFloat16{};
+    bool shaderInt8{};
+    bool storageBuffer8BitAccess{};
+    bool runtimeDescriptorArray{};             // descriptor indexing (bindless descriptors)
+    bool descriptorBindingPartiallyBound{};
+    bool descriptorBindingUpdateUnusedWhilePending{};
+    bool descriptorBindingStorageImageUpdateAfterBind{};
+    bool descriptorBindingStorageBufferUpdateAfterBind{};
+    // vulkan 1.3 features
+    bool synchronization2{};
+    bool subgroupSizeControl{};
+    bool computeFullSubgroups{};
+    bool maintenance4{};
+    // optional extensions (or core in device api version)
+    bool rayTracingPipeline{};
+    bool pipelineCreationFeedback{};
+    bool shaderObject{};                       // VK_EXT_shader_object (vulkan 1.3 devices)
+    bool pushDescriptor{};                     // VK_KHR_push_descriptor
+    bool descriptorBuffer{};                   // VK_EXT_descriptor_buffer (vulkan 1.3 devices with buffer device address)
+    // properties
+    uint32_t subgroupSize{};
+    uint32_t minSubgroupSize{};
+    uint32_t maxSubgroupSize{};
+    uint32_t maxPushConstantsSize{};
+    uint32_t maxPushDescriptors{};             // descriptors of push descriptor set (pushDescriptor only)
+    uint32_t maxUpdateAfterBindStorageImages{}; // per stage and per set limit of update after bind storage images
+    uint32_t maxUpdateAfterBindStorageBuffers{};
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties{}; // descriptor sizes and offset alignment (descriptorBuffer only)
+    uint8_t shaderBinaryUUID[VK_UUID_SIZE]{};  // shader object binary compatibility
+    uint32_t shaderBinaryVersion{};
+};
+
+// enumerate device extensions
+std::vector<VkExtensionProperties> EnumerateDeviceExtensions(VkPhysicalDevice physicalDevice);
+
+// check extension is in list
+bool HasExtension(const std::vector<VkExtensionProperties>& extensions, const char* extensionName);
+
+// query supported features and extensions, enable every wanted feature and optional extension which is present
+// enabledFeatures must stay alive (and not move) until vkCreateDevice
+DeviceCapabilities NegotiateDeviceCapabilities(VkPhysicalDevice physicalDevice, DeviceFeatureChain& enabledFeatures, std::vector<const char*>& enabledExtensions);
+
+// print negotiated capabilities
+void PrintDeviceCapabilities(const DeviceCapabilities& capabilities);
@@ -0,0 +1,116 @@
+#include "descriptor_allocator.hpp"
+#include "layout_cache.hpp"
+#include <algorithm>
+
+// allocator ids (thread local lookup must not match destroyed allocator at same address)
+static std::atomic<uint64_t> nextAllocatorId{ 1 };
+
+// thread pools of last allocator used by thread
+struct ThreadPoolsCache {
+    uint64_t allocatorId{};
+    void* threadPools{};
+};
+static thread_local ThreadPoolsCache threadPoolsCache{};
+
+DescriptorAllocator::DescriptorAllocator(VkDevice device, uint32_t framesInFlight, uint32_t setsPerPool) :
+    device(device), framesInFlight(std::max(1u, framesInFlight)), setsPerPool(std::max(1u, setsPerPool)), id(nextAllocatorId++) {}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    for (const auto& [threadId, pools] : threadPools)
+        for (const auto& framePools : pools->frames)
+            for (VkDescriptorPool pool : framePools.pools)
+                vkDestroyDescriptorPool(device, pool, VK_NULL_HANDLE);
+}
+
+// add descriptor counts of kernel sets to layout statistics
+void DescriptorAllocator::AddKernelStatistics(const SpirvReflection& reflection, uint32_t pushDescriptorSet) {
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> setBindings = GetKernelSetBindings(reflection);
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t set = 0; set < setBindings.size(); set++) {
+        if (setBindings[set].empty() || set == pushDescriptorSet || set == BindlessSet) continue;
+        for (const auto& binding : setBindings[set]) descriptorCounts[binding.descriptorType] += binding.descriptorCount;
+        setCount++;
+    }
+}
+
+// begin next frame
+uint64_t DescriptorAllocator::BeginFrame() {
+    return ++frame;
+}
+
+// get pools of calling thread (locked only on first use of thread)
+DescriptorAllocator::ThreadPools& DescriptorAllocator::GetThreadPools() {
+    if (threadPoolsCache.allocatorId == id) return *(ThreadPools*)threadPoolsCache.threadPools;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& pools = threadPools[std::this_thread::get_id()];
+    if (!pools) {
+        pools = std::make_unique<ThreadPools>();
+        pools->frames.resize(framesInFlight);
+    }
+    threadPoolsCache = { id, pools.get() };
+    return *pools;
+}
+
+// create pool sized from layout statistics
+VkDescriptorPool DescriptorAllocator::CreatePool(uint32_t maxSets) {
+    std::vector<VkDescriptorPoolSize> poolSizes{};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& [descriptorType, count] : descriptorCounts)
+            poolSizes.push_back({ descriptorType, (uint32_t)std::max<uint64_t>(1, (count * maxSets + setCount - 1) / setCount) });
+    }
+    // no statistics: storage images and buffers and uniform buffers of compute kernels
+    if (poolSizes.empty()) {
+        for (VkDescriptorType descriptorType : { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER })
+            poolSizes.push_back({ descriptorType, 4 * maxSets });
+    }
+
+    // descriptor pool create info (sets are never freed one by one)
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.pNext = VK_NULL_HANDLE;
+    descriptorPoolCreateInfo.flags = 0;
+    descriptorPoolCreateInfo.maxSets = maxSets;
+    descriptorPoolCreateInfo.poolSizeCount = (uint32_t)poolSizes.size();
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes.data();
+    VkDescriptorPool pool{};
+    vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, VK_NULL_HANDLE, &pool);
+    if (pool) poolCount++;
+    return pool;
+}
+
+// allocate descriptor set in current frame on calling thread
+VkDescriptorSet DescriptorAllocator::Allocate(VkDescriptorSetLayout setLayout) {
+    const uint64_t currentFrame = frame.load();
+    FramePools& framePools = GetThreadPools().frames[currentFrame % framesInFlight];
+
+    // first allocation of thread in frame: frame slot completed, its pools are reset wholesale
+    if (framePools.frame != currentFrame) {
+        for (VkDescriptorPool pool : framePools.pools) vkResetDescriptorPool(device, pool, 0);
+        framePools.frame = currentFrame;
+        framePools.current = 0;
+    }
+
+    // descriptor set allocate info
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.pNext = VK_NULL_HANDLE;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &setLayout;
+    for (;;) {
+        // grow: next pool is twice as large as previous one
+        if (framePools.current == framePools.pools.size()) {
+            VkDescriptorPool pool = CreatePool(setsPerPool << std::min<size_t>(framePools.pools.size(), 6));
+            if (!pool) return VK_NULL_HANDLE;
+            framePools.pools.push_back(pool);
+        }
+        descriptorSetAllocateInfo.descriptorPool = framePools.pools[framePools.current];
+        VkDescriptorSet descriptorSet{};
+        VkResult result = vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &descriptorSet);
+        if (result == VK_SUCCESS) return descriptorSet;
+        if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) return VK_NULL_HANDLE;
+        // pool is full, fresh pool can still fail when layout needs descriptor types missing from statistics
+        if (framePools.current + 1 == framePools.pools.size() && framePools.pools.size() > 8) return VK_NULL_HANDLE;
+        framePools.current++;
+    }
+}
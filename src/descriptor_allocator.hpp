@@ -0,0 +1,53 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "vulkan_loader.hpp"
+#include "spirv_reflection.hpp"
+
+// descriptor set allocator: per thread, per frame descriptor pools
+// sets are allocated from pools owned by calling thread (no lock on hot path), pools of a frame slot are reset
+// wholesale by their thread on its first allocation in the frame that reuses the slot, a full pool
+// (VK_ERROR_OUT_OF_POOL_MEMORY / VK_ERROR_FRAGMENTED_POOL) moves allocation to a new pool twice as large
+class DescriptorAllocator {
+public:
+    // pools are sized for setsPerPool sets of average kernel layout (statistics)
+    DescriptorAllocator(VkDevice device, uint32_t framesInFlight, uint32_t setsPerPool = 64);
+    ~DescriptorAllocator();
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+    // add descriptor counts of kernel sets to layout statistics (pools created later follow them),
+    // push descriptor set of kernel layout and bindless set are never allocated and not counted
+    void AddKernelStatistics(const SpirvReflection& reflection, uint32_t pushDescriptorSet = UINT32_MAX);
+    // begin next frame, returns frame number (caller waited completion of frame submitted framesInFlight frames ago)
+    uint64_t BeginFrame();
+    // allocate descriptor set in current frame on calling thread, set is valid until frame slot is reused, null on failure
+    VkDescriptorSet Allocate(VkDescriptorSetLayout setLayout);
+    // get count of created pools
+    size_t GetPoolCount() const { return poolCount.load(); }
+private:
+    struct FramePools {
+        uint64_t frame{};                    // frame number pools were last used in
+        std::vector<VkDescriptorPool> pools{};
+        size_t current{};                    // pool sets are allocated from
+    };
+    struct ThreadPools {
+        std::vector<FramePools> frames{};    // indexed by frame slot
+    };
+    ThreadPools& GetThreadPools();
+    VkDescriptorPool CreatePool(uint32_t maxSets);
+    VkDevice device{};
+    uint32_t framesInFlight{};
+    uint32_t setsPerPool{};
+    uint64_t id{};                           // allocator id of thread local pool lookup
+    std::atomic<uint64_t> frame{};
+    std::atomic<size_t> poolCount{};
+    std::mutex mutex{};                      // statistics and thread registration
+    std::map<VkDescriptorType, uint64_t> descriptorCounts{};
+    uint64_t setCount{};
+    std::map<std::thread::id, std::unique_ptr<ThreadPools>> threadPools{};
+};
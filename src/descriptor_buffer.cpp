@@ -0,0 +1,132 @@
+#include "descriptor_buffer.hpp"
+#include <iostream>
+#include <algorithm>
+
+// align offset up
+static VkDeviceSize AlignUp(VkDeviceSize offset, VkDeviceSize alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// create ring
+DescriptorBufferRing::DescriptorBufferRing(VkDevice device, const DeviceCapabilities& capabilities, VkBuffer buffer, void* mappedData, VkDeviceSize size,
+    uint32_t framesInFlight) :
+    device(device), properties(capabilities.descriptorBufferProperties), mappedData((uint8_t*)mappedData), framesInFlight(std::max(1u, framesInFlight)) {
+    // frame regions start at set offset alignment
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(1, properties.descriptorBufferOffsetAlignment);
+    regionSize = size / this->framesInFlight / alignment * alignment;
+    if (!capabilities.descriptorBuffer || !regionSize || !mappedData) {
+        std::cout << "Descriptor buffer: " << size << " bytes can't be split into " << this->framesInFlight << " frames" << std::endl;
+        regionSize = 0;
+        return;
+    }
+
+    // buffer device address info
+    VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+    bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    bufferDeviceAddressInfo.pNext = VK_NULL_HANDLE;
+    bufferDeviceAddressInfo.buffer = buffer;
+    address = vkGetBufferDeviceAddress(device, &bufferDeviceAddressInfo);
+}
+
+// advance to region of next frame
+void DescriptorBufferRing::NextFrame() {
+    frameIndex = (frameIndex + 1) % framesInFlight;
+    regionOffset = 0;
+}
+
+// get layout size and binding offsets (queried once per layout)
+const DescriptorBufferRing::LayoutInfo& DescriptorBufferRing::GetLayoutInfo(VkDescriptorSetLayout setLayout) {
+    auto cached = layouts.find(setLayout);
+    if (cached != layouts.end()) return cached->second;
+    LayoutInfo& info = layouts[setLayout];
+    vkGetDescriptorSetLayoutSizeEXT(device, setLayout, &info.size);
+    return info;
+}
+
+// get descriptor size of type
+size_t DescriptorBufferRing::GetDescriptorSize(VkDescriptorType descriptorType) const {
+    switch (descriptorType) {
+        case VK_DESCRIPTOR_TYPE_SAMPLER: return properties.samplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: return properties.combinedImageSamplerDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE: return properties.sampledImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: return properties.storageImageDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: return properties.uniformBufferDescriptorSize;
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER: return properties.storageBufferDescriptorSize;
+        default: return 0;
+    }
+}
+
+// allocate set in region of current frame
+DescriptorBufferSet DescriptorBufferRing::Allocate(VkDescriptorSetLayout setLayout) {
+    if (!regionSize) return {};
+    const LayoutInfo& info = GetLayoutInfo(setLayout);
+    const VkDeviceSize offset = AlignUp(regionOffset, std::max<VkDeviceSize>(1, properties.descriptorBufferOffsetAlignment));
+    if (offset + info.size > regionSize) return {};
+    regionOffset = offset + info.size;
+    allocationCount++;
+    const VkDeviceSize bufferOffset = frameIndex * regionSize + offset;
+    return { setLayout, bufferOffset, mappedData + bufferOffset };
+}
+
+// write descriptors of set data
+bool DescriptorBufferRing::Write(const DescriptorBufferSet& set, const DescriptorSetData& data) {
+    if (!set) return false;
+    LayoutInfo& info = layouts[set.setLayout];
+    const DescriptorInfo* infos = data.GetData();
+    for (const auto& binding : data.GetBindings()) {
+        const size_t descriptorSize = GetDescriptorSize(binding.descriptorType);
+        if (!descriptorSize) return false;
+        // binding offset (queried once per binding)
+        auto bindingOffset = info.bindingOffsets.find(binding.binding);
+        if (bindingOffset == info.bindingOffsets.end()) {
+            VkDeviceSize offset{};
+            vkGetDescriptorSetLayoutBindingOffsetEXT(device, set.setLayout, binding.binding, &offset);
+            bindingOffset = info.bindingOffsets.emplace(binding.binding, offset).first;
+        }
+        for (uint32_t i = 0; i < binding.descriptorCount; i++, infos++) {
+            // descriptor get info (buffers by device address)
+            VkDescriptorAddressInfoEXT addressInfo{};
+            VkDescriptorGetInfoEXT descriptorGetInfo{};
+            descriptorGetInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+            descriptorGetInfo.pNext = VK_NULL_HANDLE;
+            descriptorGetInfo.type = binding.descriptorType;
+            if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) {
+                if (!infos->buffer.buffer || infos->buffer.range == VK_WHOLE_SIZE) return false;
+                VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+                bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+                bufferDeviceAddressInfo.pNext = VK_NULL_HANDLE;
+                bufferDeviceAddressInfo.buffer = infos->buffer.buffer;
+                addressInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+                addressInfo.pNext = VK_NULL_HANDLE;
+                addressInfo.address = vkGetBufferDeviceAddress(device, &bufferDeviceAddressInfo) + infos->buffer.offset;
+                addressInfo.range = infos->buffer.range;
+                addressInfo.format = VK_FORMAT_UNDEFINED;
+                if (binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) descriptorGetInfo.data.pUniformBuffer = &addressInfo;
+                else descriptorGetInfo.data.pStorageBuffer = &addressInfo;
+            } else if (binding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER) {
+                descriptorGetInfo.data.pSampler = &infos->image.sampler;
+            } else {
+                // image infos share union member layout
+                descriptorGetInfo.data.pStorageImage = &infos->image;
+            }
+            vkGetDescriptorEXT(device, &descriptorGetInfo, descriptorSize, set.data + bindingOffset->second + i * descriptorSize);
+        }
+    }
+    return true;
+}
+
+// bind descriptor buffer
+void DescriptorBufferRing::Bind(VkCommandBuffer commandBuffer) const {
+    VkDescriptorBufferBindingInfoEXT bindingInfo{};
+    bindingInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+    bindingInfo.pNext = VK_NULL_HANDLE;
+    bindingInfo.address = address;
+    bindingInfo.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT;
+    vkCmdBindDescriptorBuffersEXT(commandBuffer, 1, &bindingInfo);
+}
+
+// bind set by offset into descriptor buffer 0
+void DescriptorBufferRing::BindSet(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, const DescriptorBufferSet& descriptorSet) const {
+    const uint32_t bufferIndex = 0;
+    vkCmdSetDescriptorBufferOffsetsEXT(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, set, 1, &bufferIndex, &descriptorSet.offset);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <cstdint>
+#include "vulkan_loader.hpp"
+#include "capabilities.hpp"
+#include "descriptor_update.hpp"
+
+// descriptor set suballocated from descriptor buffer: offset of its descriptors and host pointer into mapped buffer
+struct DescriptorBufferSet {
+    VkDescriptorSetLayout setLayout{};
+    VkDeviceSize offset{};
+    uint8_t* data{};
+    // check set was allocated
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// descriptor buffer ring (VK_EXT_descriptor_buffer): descriptors are written with vkGetDescriptorEXT straight into
+// resource descriptor buffer split into one region per frame in flight, sets are suballocated linearly in region of
+// current frame and bound by offset, so recording needs no pools, no descriptor sets and no vkUpdateDescriptorSets
+// set layouts must be descriptor buffer layouts (LayoutCache with descriptorBuffer), used by one recording thread
+class DescriptorBufferRing {
+public:
+    // buffer: resource descriptor buffer with device address usage, host visible and coherent, persistently mapped by caller
+    DescriptorBufferRing(VkDevice device, const DeviceCapabilities& capabilities, VkBuffer buffer, void* mappedData, VkDeviceSize size, uint32_t framesInFlight);
+    DescriptorBufferRing(const DescriptorBufferRing&) = delete;
+    DescriptorBufferRing& operator=(const DescriptorBufferRing&) = delete;
+    // advance to region of next frame (caller ensures frame submitted framesInFlight frames ago finished)
+    void NextFrame();
+    // allocate set of layout in region of current frame, null data when region is full
+    DescriptorBufferSet Allocate(VkDescriptorSetLayout setLayout);
+    // write descriptors of set data (buffers need explicit ranges, texel buffers and dynamic buffers are not supported)
+    bool Write(const DescriptorBufferSet& set, const DescriptorSetData& data);
+    // bind descriptor buffer, once per command buffer before set offsets
+    void Bind(VkCommandBuffer commandBuffer) const;
+    // bind set at set number of pipeline layout
+    void BindSet(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t set, const DescriptorBufferSet& descriptorSet) const;
+    // get count of allocated sets
+    uint64_t GetAllocationCount() const { return allocationCount; }
+private:
+    struct LayoutInfo {
+        VkDeviceSize size{};
+        std::map<uint32_t, VkDeviceSize> bindingOffsets{};
+    };
+    const LayoutInfo& GetLayoutInfo(VkDescriptorSetLayout setLayout);
+    size_t GetDescriptorSize(VkDescriptorType descriptorType) const;
+    VkDevice device{};
+    VkPhysicalDeviceDescriptorBufferPropertiesEXT properties{};
+    VkDeviceAddress address{};
+    uint8_t* mappedData{};
+    VkDeviceSize regionSize{};
+    uint32_t framesInFlight{};
+    uint32_t frameIndex{};
+    VkDeviceSize regionOffset{}; // allocation offset within current region
+    uint64_t allocationCount{};
+    std::map<VkDescriptorSetLayout, LayoutInfo> layouts{};
+};
@@ -0,0 +1,108 @@
+#include "descriptor_update.hpp"
+#include <algorithm>
+
+// packed infos must match VkDescriptorImageInfo and VkDescriptorBufferInfo members of typed structs
+static_assert(sizeof(DescriptorInfo) == sizeof(VkDescriptorImageInfo) && sizeof(DescriptorInfo) == sizeof(VkDescriptorBufferInfo), "unexpected descriptor info size");
+
+// sort bindings by binding number
+static std::vector<VkDescriptorSetLayoutBinding> SortBindings(const std::vector<VkDescriptorSetLayoutBinding>& bindings) {
+    std::vector<VkDescriptorSetLayoutBinding> sortedBindings = bindings;
+    std::sort(sortedBindings.begin(), sortedBindings.end(), [](const auto& a, const auto& b) { return a.binding < b.binding; });
+    return sortedBindings;
+}
+
+// get update template entries of set bindings
+std::vector<VkDescriptorUpdateTemplateEntry> GetDescriptorTemplateEntries(const std::vector<VkDescriptorSetLayoutBinding>& bindings) {
+    std::vector<VkDescriptorUpdateTemplateEntry> entries{};
+    size_t index = 0;
+    for (const auto& binding : SortBindings(bindings)) {
+        entries.push_back({ binding.binding, 0, binding.descriptorCount, binding.descriptorType, index * sizeof(DescriptorInfo), sizeof(DescriptorInfo) });
+        index += binding.descriptorCount;
+    }
+    return entries;
+}
+
+// get size of update template data read through entries
+size_t GetDescriptorTemplateDataSize(const std::vector<VkDescriptorUpdateTemplateEntry>& entries) {
+    size_t size = 0;
+    for (const auto& entry : entries)
+        if (entry.descriptorCount) size = std::max(size, entry.offset + (entry.descriptorCount - 1) * entry.stride + sizeof(DescriptorInfo));
+    return size;
+}
+
+DescriptorSetData::DescriptorSetData(const std::vector<VkDescriptorSetLayoutBinding>& bindings) : bindings(SortBindings(bindings)) {
+    uint32_t index = 0;
+    for (const auto& binding : this->bindings) {
+        offsets.push_back(index);
+        index += binding.descriptorCount;
+    }
+    infos.resize(index);
+
+    // write descriptor sets of bindings (info pointers are set per write, so copies of set data stay valid)
+    writes.resize(this->bindings.size());
+    size_t texelBufferViewCount = 0;
+    for (size_t i = 0; i < this->bindings.size(); i++) {
+        const VkDescriptorType descriptorType = this->bindings[i].descriptorType;
+        const bool texelBuffer = descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER || descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+        const bool buffer = descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER ||
+            descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].pNext = VK_NULL_HANDLE;
+        writes[i].dstSet = VK_NULL_HANDLE;
+        writes[i].dstBinding = this->bindings[i].binding;
+        writes[i].dstArrayElement = 0;
+        writes[i].descriptorCount = this->bindings[i].descriptorCount;
+        writes[i].descriptorType = descriptorType;
+        writes[i].pImageInfo = !buffer && !texelBuffer ? &infos[offsets[i]].image : VK_NULL_HANDLE;
+        writes[i].pBufferInfo = buffer ? &infos[offsets[i]].buffer : VK_NULL_HANDLE;
+        writes[i].pTexelBufferView = VK_NULL_HANDLE;
+        if (texelBuffer) texelBufferViewCount += this->bindings[i].descriptorCount;
+    }
+    texelBufferViews.resize(texelBufferViewCount);
+}
+
+// find info of binding array element
+DescriptorInfo* DescriptorSetData::Find(uint32_t binding, uint32_t arrayElement) {
+    for (size_t i = 0; i < bindings.size(); i++)
+        if (bindings[i].binding == binding && arrayElement < bindings[i].descriptorCount)
+            return &infos[offsets[i] + arrayElement];
+    return nullptr;
+}
+
+// set image descriptor
+DescriptorSetData& DescriptorSetData::SetImage(uint32_t binding, VkImageView imageView, VkImageLayout imageLayout, VkSampler sampler, uint32_t arrayElement) {
+    if (DescriptorInfo* info = Find(binding, arrayElement)) info->image = { sampler, imageView, imageLayout };
+    return *this;
+}
+
+// set buffer descriptor
+DescriptorSetData& DescriptorSetData::SetBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range, uint32_t arrayElement) {
+    if (DescriptorInfo* info = Find(binding, arrayElement)) info->buffer = { buffer, offset, range };
+    return *this;
+}
+
+// set texel buffer descriptor
+DescriptorSetData& DescriptorSetData::SetTexelBuffer(uint32_t binding, VkBufferView bufferView, uint32_t arrayElement) {
+    if (DescriptorInfo* info = Find(binding, arrayElement)) info->texelBufferView = bufferView;
+    return *this;
+}
+
+// update set with one template call
+void DescriptorSetData::Update(VkDevice device, VkDescriptorSet descriptorSet, VkDescriptorUpdateTemplate updateTemplate) const {
+    vkUpdateDescriptorSetWithTemplate(device, descriptorSet, updateTemplate, infos.data());
+}
+
+// update set through VkWriteDescriptorSet array (no allocation, writes are built in constructor)
+void DescriptorSetData::Write(VkDevice device, VkDescriptorSet descriptorSet) {
+    size_t texelBufferViewCount = 0;
+    for (size_t i = 0; i < writes.size(); i++) {
+        writes[i].dstSet = descriptorSet;
+        if (writes[i].pImageInfo) writes[i].pImageInfo = &infos[offsets[i]].image;
+        if (writes[i].pBufferInfo) writes[i].pBufferInfo = &infos[offsets[i]].buffer;
+        if (writes[i].descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER || writes[i].descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER) {
+            writes[i].pTexelBufferView = &texelBufferViews[texelBufferViewCount];
+            for (uint32_t j = 0; j < bindings[i].descriptorCount; j++) texelBufferViews[texelBufferViewCount++] = infos[offsets[i] + j].texelBufferView;
+        }
+    }
+    vkUpdateDescriptorSets(device, (uint32_t)writes.size(), writes.data(), 0, VK_NULL_HANDLE);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include "vulkan_loader.hpp"
+
+// packed descriptor of update template data (image, buffer or texel buffer view, 24 bytes)
+union DescriptorInfo {
+    VkDescriptorImageInfo image;
+    VkDescriptorBufferInfo buffer;
+    VkBufferView texelBufferView;
+};
+
+// get update template entries of set bindings: one DescriptorInfo per descriptor, bindings in ascending order
+// (typed host structs of VkDescriptorImageInfo / VkDescriptorBufferInfo members in binding order match this layout)
+std::vector<VkDescriptorUpdateTemplateEntry> GetDescriptorTemplateEntries(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+
+// descriptor data of one kernel set packed in update template order
+class DescriptorSetData {
+public:
+    explicit DescriptorSetData(const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+    // set storage/sampled image or sampler descriptor
+    DescriptorSetData& SetImage(uint32_t binding, VkImageView imageView, VkImageLayout imageLayout, VkSampler sampler = VK_NULL_HANDLE, uint32_t arrayElement = 0);
+    // set uniform/storage buffer descriptor
+    DescriptorSetData& SetBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE, uint32_t arrayElement = 0);
+    // set texel buffer descriptor
+    DescriptorSetData& SetTexelBuffer(uint32_t binding, VkBufferView bufferView, uint32_t arrayElement = 0);
+    // get packed data (update template data)
+    const DescriptorInfo* GetData() const { return infos.data(); }
+    // get bindings in packed data order (ascending binding number, descriptorCount infos each)
+    const std::vector<VkDescriptorSetLayoutBinding>& GetBindings() const { return bindings; }
+    // update set with one template call
+    void Update(VkDevice device, VkDescriptorSet descriptorSet, VkDescriptorUpdateTemplate updateTemplate) const;
+    // update set through VkWriteDescriptorSet array (path without template, benchmark reference),
+    // writes prebuilt in constructor are patched, so it is not const and one set data is written by one thread at a time
+    void Write(VkDevice device, VkDescriptorSet descriptorSet);
+private:
+    DescriptorInfo* Find(uint32_t binding, uint32_t arrayElement);
+    std::vector<VkDescriptorSetLayoutBinding> bindings{}; // sorted by binding
+    std::vector<uint32_t> offsets{};                      // first info index per binding
+    std::vector<DescriptorInfo> infos{};
+    // VkWriteDescriptorSet path state built once in constructor, set and info pointers are patched per write
+    std::vector<VkWriteDescriptorSet> writes{};
+    std::vector<VkBufferView> texelBufferViews{}; // texel buffer views gathered contiguously (infos are 24 byte strided)
+};
+
+// get size of update template data read through entries (end of last descriptor info)
+size_t GetDescriptorTemplateDataSize(const std::vector<VkDescriptorUpdateTemplateEntry>& entries);
+
+// update set from typed packed struct with one template call (templateDataSize from kernel layout),
+// returns false without update when struct is smaller than data read by template
+template <typename T>
+bool UpdateDescriptorSet(VkDevice device, VkDescriptorSet descriptorSet, VkDescriptorUpdateTemplate updateTemplate, size_t templateDataSize, const T& data) {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(DescriptorInfo) == 0, "descriptor data must be packed descriptor infos");
+    if (sizeof(T) < templateDataSize) return false;
+    vkUpdateDescriptorSetWithTemplate(device, descriptorSet, updateTemplate, &data);
+    return true;
+}
+
+// record push descriptor set from typed packed struct with push update template (no descriptor set allocation),
+// returns false without recording when struct is smaller than data read by template
+template <typename T>
+bool PushDescriptorSet(VkCommandBuffer commandBuffer, VkDescriptorUpdateTemplate updateTemplate, size_t templateDataSize, VkPipelineLayout pipelineLayout, uint32_t set,
+    const T& data) {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(DescriptorInfo) == 0, "descriptor data must be packed descriptor infos");
+    if (sizeof(T) < templateDataSize) return false;
+    vkCmdPushDescriptorSetWithTemplateKHR(commandBuffer, updateTemplate, pipelineLayout, set, &data);
+    return true;
+}
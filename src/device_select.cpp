@@ -0,0 +1,158 @@
+#include "device_select.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+// query physical device properties, heaps and queue families
+PhysicalDeviceInfo QueryPhysicalDeviceInfo(VkPhysicalDevice physicalDevice, uint32_t index) {
+    PhysicalDeviceInfo info{};
+    info.physicalDevice = physicalDevice;
+    info.index = index;
+
+    // properties and subgroup properties
+    info.subgroupProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+    info.subgroupProperties.pNext = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties2 properties2{};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &info.subgroupProperties;
+    vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+    info.properties = properties2.properties;
+    info.subgroupProperties.pNext = VK_NULL_HANDLE;
+
+    // largest device local heap
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+        if (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+            info.deviceLocalHeapSize = std::max(info.deviceLocalHeapSize, memoryProperties.memoryHeaps[i].size);
+
+    // queue families
+    uint32_t queueFamilyCount{};
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, VK_NULL_HANDLE);
+    info.queueFamilies.resize(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, info.queueFamilies.data());
+    info.computeQueueFamilyIndex = FindComputeQueueFamily(info.queueFamilies);
+
+    // score
+    info.score = ScorePhysicalDevice(info);
+    return info;
+}
+
+// find queue family for compute work
+uint32_t FindComputeQueueFamily(const std::vector<VkQueueFamilyProperties>& queueFamilies) {
+    uint32_t queueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    for (uint32_t i = 0; i < (uint32_t)queueFamilies.size(); i++) {
+        const VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if (!(flags & VK_QUEUE_COMPUTE_BIT) || queueFamilies[i].queueCount == 0) continue;
+        // universal family is the safest place for the main queue
+        if (flags & VK_QUEUE_GRAPHICS_BIT) return i;
+        if (queueFamilyIndex == VK_QUEUE_FAMILY_IGNORED) queueFamilyIndex = i;
+    }
+    return queueFamilyIndex;
+}
+
+// score physical device for compute throughput
+int64_t ScorePhysicalDevice(const PhysicalDeviceInfo& info) {
+    // device without compute queue is unusable
+    if (info.computeQueueFamilyIndex == VK_QUEUE_FAMILY_IGNORED) return -1;
+
+    // device type dominates score
+    int64_t score{};
+    switch (info.properties.deviceType) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   score = 1000000; break;
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: score =  100000; break;
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    score =   10000; break;
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            score =    1000; break;
+    default:                                     score =     100; break;
+    }
+
+    // compute capable queue families (dedicated compute family allows async compute)
+    for (const auto& queueFamily : info.queueFamilies) {
+        if (!(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT)) continue;
+        score += 100 * std::min<uint32_t>(queueFamily.queueCount, 4);
+        if (!(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)) score += 1000;
+    }
+
+    // device local memory (per 256 MB)
+    score += int64_t(info.deviceLocalHeapSize >> 28) * 100;
+
+    // subgroup size and compute workgroup limits
+    if (info.subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT)
+        score += info.subgroupProperties.subgroupSize * 10;
+    score += info.properties.limits.maxComputeWorkGroupInvocations / 8;
+    score += info.properties.limits.maxComputeSharedMemorySize / 1024;
+    return score;
+}
+
+// get physical device type name
+const char* GetPhysicalDeviceTypeName(VkPhysicalDeviceType type) {
+    switch (type) {
+    case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:   return "discrete";
+    case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+    case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:    return "virtual";
+    case VK_PHYSICAL_DEVICE_TYPE_CPU:            return "cpu";
+    default:                                     return "other";
+    }
+}
+
+// case insensitive substring search
+static bool ContainsNoCase(std::string_view text, std::string_view pattern) {
+    return std::search(text.begin(), text.end(), pattern.begin(), pattern.end(),
+        [](char a, char b) { return std::tolower((unsigned char)a) == std::tolower((unsigned char)b); }) != text.end();
+}
+
+// select physical device
+PhysicalDeviceInfo SelectPhysicalDevice(VkInstance instance, const std::string& deviceOverride) {
+    // get physical devices
+    uint32_t physicalDevicesCount{};
+    vkEnumeratePhysicalDevices(instance, &physicalDevicesCount, VK_NULL_HANDLE);
+    std::vector<VkPhysicalDevice> physicalDevices(physicalDevicesCount);
+    vkEnumeratePhysicalDevices(instance, &physicalDevicesCount, physicalDevices.data());
+
+    // query and rank devices
+    std::vector<PhysicalDeviceInfo> infos{};
+    for (uint32_t i = 0; i < physicalDevicesCount; i++)
+        infos.push_back(QueryPhysicalDeviceInfo(physicalDevices[i], i));
+    std::stable_sort(infos.begin(), infos.end(), [](const auto& a, const auto& b) { return a.score > b.score; });
+
+    // report ranking
+    std::cout << "Physical devices:" << std::endl;
+    for (const auto& info : infos) {
+        std::cout << "  [" << info.index << "] " << info.properties.deviceName;
+        std::cout << " (" << GetPhysicalDeviceTypeName(info.properties.deviceType);
+        std::cout << ", " << (info.deviceLocalHeapSize >> 20) << " MB";
+        std::cout << ", subgroup " << info.subgroupProperties.subgroupSize;
+        std::cout << ", max invocations " << info.properties.limits.maxComputeWorkGroupInvocations;
+        std::cout << ") score " << info.score << std::endl;
+    }
+
+    // apply override (device index or name substring)
+    PhysicalDeviceInfo selected{};
+    if (!deviceOverride.empty()) {
+        // index when override is a decimal number below device count, name substring otherwise (e.g. "4090")
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long index = std::strtoul(deviceOverride.c_str(), &end, 10);
+        const bool isIndex = std::isdigit((unsigned char)deviceOverride[0]) && *end == '\0' && errno == 0 && index < physicalDevicesCount;
+        auto it = std::find_if(infos.begin(), infos.end(), [&](const auto& info) {
+            return isIndex ? info.index == index : ContainsNoCase(info.properties.deviceName, deviceOverride);
+        });
+        if (it != infos.end() && it->score >= 0)
+            selected = *it;
+        else
+            std::cout << "Device override \"" << deviceOverride << "\" does not match usable device, using ranking" << std::endl;
+    }
+    if (!selected.physicalDevice && !infos.empty() && infos.front().score >= 0)
+        selected = infos.front();
+
+    // report choice
+    if (selected.physicalDevice) {
+        std::cout << "Selected device: [" << selected.index << "] " << selected.properties.deviceName;
+        std::cout << ", queue family " << selected.computeQueueFamilyIndex << std::endl;
+    } else
+        std::cout << "No usable physical device found" << std::endl;
+    return selected;
+}
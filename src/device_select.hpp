@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "vulkan_loader.hpp"
+
+// physical device description used for ranking
+struct PhysicalDeviceInfo {
+    VkPhysicalDevice physicalDevice{};
+    uint32_t index{};
+    VkPhysicalDeviceProperties properties{};
+    VkPhysicalDeviceSubgroupProperties subgroupProperties{};
+    VkDeviceSize deviceLocalHeapSize{};
+    std::vector<VkQueueFamilyProperties> queueFamilies{};
+    uint32_t computeQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    int64_t score = -1;
+};
+
+// query physical device properties, heaps and queue families
+PhysicalDeviceInfo QueryPhysicalDeviceInfo(VkPhysicalDevice physicalDevice, uint32_t index);
+
+// find queue family for compute work (universal family preferred), returns VK_QUEUE_FAMILY_IGNORED if none
+uint32_t FindComputeQueueFamily(const std::vector<VkQueueFamilyProperties>& queueFamilies);
+
+// score physical device for compute throughput, negative score means device is unusable
+int64_t ScorePhysicalDevice(const PhysicalDeviceInfo& info);
+
+// get physical device type name
+const char* GetPhysicalDeviceTypeName(VkPhysicalDeviceType type);
+
+// select physical device: ranked by score or forced by override
+// override is device index ("1") or case insensitive device name substring ("lavapipe")
+// returns info with null physicalDevice if no usable device found
+PhysicalDeviceInfo SelectPhysicalDevice(VkInstance instance, const std::string& deviceOverride);
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// 64-bit FNV-1a hash accumulator
+struct Hasher {
+    uint64_t value = 0xcbf29ce484222325ull;
+    // add raw bytes
+    Hasher& Add(const void* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            value ^= ((const uint8_t*)data)[i];
+            value *= 0x100000001b3ull;
+        }
+        return *this;
+    }
+    // add string with length prefix (so "ab"+"c" and "a"+"bc" differ)
+    Hasher& Add(std::string_view text) {
+        const uint64_t size = text.size();
+        return Add(&size, sizeof(size)).Add(text.data(), text.size());
+    }
+    // add trivially copyable value
+    template <typename T>
+    Hasher& AddValue(const T& data) { return Add(&data, sizeof(T)); }
+};
+
+// hash value as 16 hex digits
+inline std::string HashToString(uint64_t hash) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; i--, hash >>= 4) text[i] = digits[hash & 0xf];
+    return text;
+}
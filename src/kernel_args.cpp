@@ -0,0 +1,24 @@
+#include "kernel_args.hpp"
+#include <iostream>
+
+// check host members match reflected push constant block
+bool CheckKernelArgs(const char* kernel, const SpirvReflection& reflection, const KernelArgMember* members, size_t memberCount, uint32_t size) {
+    bool match = true;
+    if (reflection.pushConstantSize != size) {
+        std::cout << "Kernel " << kernel << ": arguments are " << size << " bytes, push constant block " << reflection.pushConstantSize << " bytes" << std::endl;
+        match = false;
+    }
+    if (reflection.pushConstantMembers.size() != memberCount) {
+        std::cout << "Kernel " << kernel << ": arguments have " << memberCount << " members, push constant block " << reflection.pushConstantMembers.size() << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < memberCount; i++) {
+        const SpirvPushConstantMember& expected = reflection.pushConstantMembers[i];
+        if (members[i].offset == expected.offset && members[i].size == expected.size && members[i].pointer == expected.pointer) continue;
+        std::cout << "Kernel " << kernel << ": argument " << members[i].name << " (offset " << members[i].offset << ", " << members[i].size << " bytes";
+        std::cout << (members[i].pointer ? ", pointer" : "") << ") does not match " << (expected.name.empty() ? "member" : expected.name.c_str());
+        std::cout << " (offset " << expected.offset << ", " << expected.size << " bytes" << (expected.pointer ? ", pointer" : "") << ")" << std::endl;
+        match = false;
+    }
+    return match;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "vulkan_loader.hpp"
+#include "spirv_reflection.hpp"
+
+// device address of buffer reference block T (BUFFER_POINTER of shaders/include/pointers.glsl), 8 byte aligned like GLSL pointers
+template <typename T>
+struct alignas(8) DevicePointer {
+    VkDeviceAddress address{};
+    // pointer to element at index (address arithmetic of host struct layout)
+    DevicePointer operator+(VkDeviceSize index) const { return { address + index * sizeof(T) }; }
+    explicit operator bool() const { return address != 0; }
+};
+
+// check member type is device pointer
+template <typename T>
+struct IsDevicePointer : std::false_type {};
+template <typename T>
+struct IsDevicePointer<DevicePointer<T>> : std::true_type {};
+
+// host member of kernel argument struct (KERNEL_ARGS block of kernel)
+struct KernelArgMember {
+    uint32_t offset{};
+    uint32_t size{};
+    bool pointer{};
+    const char* name{};
+};
+
+// describe member of argument struct: KERNEL_ARG(BufferFillArgs, pixels)
+#define KERNEL_ARG(Args, member) KernelArgMember{ (uint32_t)offsetof(Args, member), (uint32_t)sizeof(Args::member), \
+    IsDevicePointer<std::remove_cv_t<decltype(Args::member)>>::value, #member }
+
+// get device address of buffer (created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+template <typename T>
+DevicePointer<T> GetDevicePointer(VkDevice device, VkBuffer buffer, VkDeviceSize offset = 0) {
+    VkBufferDeviceAddressInfo bufferDeviceAddressInfo{};
+    bufferDeviceAddressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    bufferDeviceAddressInfo.pNext = VK_NULL_HANDLE;
+    bufferDeviceAddressInfo.buffer = buffer;
+    return { vkGetBufferDeviceAddress(device, &bufferDeviceAddressInfo) + offset };
+}
+
+// check host members match reflected push constant block (offset, size and pointer of every member, block size),
+// prints mismatches, returns false when kernel can't take the struct
+bool CheckKernelArgs(const char* kernel, const SpirvReflection& reflection, const KernelArgMember* members, size_t memberCount, uint32_t size);
+
+// check typed argument struct against kernel (members in declaration order)
+template <typename T, size_t N>
+bool CheckKernelArgs(const char* kernel, const SpirvReflection& reflection, const KernelArgMember (&members)[N]) {
+    static_assert(std::is_trivially_copyable_v<T>, "kernel arguments must be trivially copyable");
+    static_assert(sizeof(T) % 4 == 0, "kernel argument size must be multiple of 4");
+    return CheckKernelArgs(kernel, reflection, members, N, (uint32_t)sizeof(T));
+}
@@ -0,0 +1,99 @@
+#include "kernel_builder.hpp"
+#include "bench.hpp"
+#include <iostream>
+#ifndef VKC_NO_SHADERC
+#include "shader_compiler.hpp"
+#endif
+
+// build one kernel (runs on worker thread)
+static void BuildKernel(PipelineRegistry& registry, const KernelCompileContext* context, LayoutCache& layoutCache, const KernelBuildRequest& request, KernelBuild& build) {
+    // SPIR-V
+    Stopwatch spirvStopwatch{};
+    build.code = GetKernelSpirv(context, request.kernel.c_str(), request.variant.c_str());
+    build.spirvMs = spirvStopwatch.ElapsedMs();
+    if (build.code.empty()) return;
+
+    // reflection and layout (shared with kernels of identical layout)
+    if (!ReflectSpirv(build.code.data(), build.code.size(), build.reflection)) {
+        std::cout << "Kernel " << request.kernel << "." << request.variant << ": invalid SPIR-V" << std::endl;
+        return;
+    }
+    if (request.pipelineLayout) build.layout.pipelineLayout = request.pipelineLayout;
+    else build.layout = layoutCache.GetKernelLayout(build.reflection);
+    if (!build.layout.pipelineLayout) return;
+
+    // shader module (shared by identical SPIR-V)
+    Stopwatch moduleStopwatch{};
+    const uint64_t moduleHash = registry.AddModule(build.code, &build.shaderModule);
+    build.moduleMs = moduleStopwatch.ElapsedMs();
+    if (!build.shaderModule) return;
+
+    // initial pipeline is created in background, further specializations are requested on use
+    build.specializations = std::make_unique<SpecializedKernel>(registry, moduleHash, build.layout, build.reflection);
+    build.pipeline = build.specializations->RequestPipeline(request.specConstants);
+    build.specConstants = request.specConstants;
+}
+
+// build kernels on worker pool
+std::vector<KernelBuild> BuildKernels(ThreadPool& threadPool, PipelineRegistry& registry, const KernelCompileContext* context, LayoutCache& layoutCache,
+    const std::vector<KernelBuildRequest>& requests) {
+    std::vector<KernelBuild> builds(requests.size());
+    std::vector<std::future<void>> futures{};
+    for (size_t i = 0; i < requests.size(); i++)
+        futures.push_back(threadPool.Submit([&, i](uint32_t) { BuildKernel(registry, context, layoutCache, requests[i], builds[i]); }));
+    for (auto& future : futures) future.get();
+    return builds;
+}
+
+// print per kernel timings
+void PrintKernelBuildTimings(const std::vector<KernelBuildRequest>& requests, const std::vector<KernelBuild>& builds, double totalMs) {
+    std::cout << "Kernel build: " << requests.size() << " kernels in " << totalMs << " ms" << std::endl;
+    for (size_t i = 0; i < requests.size(); i++) {
+        std::cout << "  " << requests[i].kernel << "." << requests[i].variant << ":";
+        std::cout << " spirv " << builds[i].spirvMs << " ms";
+        std::cout << ", module " << builds[i].moduleMs << " ms";
+        if (!builds[i].pipeline.IsValid()) std::cout << " (failed)";
+        std::cout << std::endl;
+    }
+}
+
+#ifndef VKC_NO_SHADERC
+// compile kernels at every optimization level and print SPIR-V size and gpu time
+void ReportKernelOptimizationLevels(ThreadPool& threadPool, VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod,
+    const KernelCompileContext& context, LayoutCache& layoutCache, const std::vector<KernelBuildRequest>& requests,
+    const std::function<bool(VkCommandBuffer, size_t requestIndex, const KernelBuild&)>& bind,
+    const std::function<void(VkCommandBuffer, size_t requestIndex, const KernelProgram&)>& recordDispatch) {
+    const shaderc_optimization_level optimizationLevels[] = { shaderc_optimization_level_zero, shaderc_optimization_level_size, shaderc_optimization_level_performance };
+    const uint32_t iterations = 100;
+    std::cout << "Kernel optimization levels:" << std::endl;
+    for (shaderc_optimization_level optimizationLevel : optimizationLevels) {
+        // same context with optimization level override, always compiled from source
+        ShaderCompileOptions options = context.options ? *context.options : ShaderCompileOptions{};
+        options.optimizationLevel = optimizationLevel;
+        KernelCompileContext levelContext = context;
+        levelContext.options = &options;
+        levelContext.preferEmbedded = false;
+        // level pipelines live in their own registry (no pipeline cache) and are destroyed after measurement
+        PipelineRegistry registry(device, threadPool, nullptr);
+        std::vector<KernelBuild> builds = BuildKernels(threadPool, registry, &levelContext, layoutCache, requests);
+        for (size_t i = 0; i < requests.size(); i++) {
+            std::cout << "  " << requests[i].kernel << "." << requests[i].variant << " [" << GetOptimizationLevelName(optimizationLevel) << "]:";
+            const KernelProgram program = registry.Get(builds[i].pipeline);
+            if (!program) {
+                std::cout << " failed" << std::endl;
+                continue;
+            }
+            std::cout << " spirv " << builds[i].code.size() * sizeof(uint32_t) << " bytes";
+            // level layouts may differ (bindings optimized out), resources are bound through layout of level build
+            bool bound = true;
+            double gpuMs = MeasureGpuTimeMs(device, queue, queueFamilyIndex, timestampPeriod,
+                [&](VkCommandBuffer commandBuffer) { recordDispatch(commandBuffer, i, program); }, iterations,
+                [&](VkCommandBuffer commandBuffer) { return bound = bind(commandBuffer, i, builds[i]); });
+            if (gpuMs >= 0.0) std::cout << ", gpu " << gpuMs << " ms";
+            else if (!bound) std::cout << ", resources not bound";
+            else std::cout << ", gpu timestamps not supported";
+            std::cout << std::endl;
+        }
+    }
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include "kernels.hpp"
+#include "thread_pool.hpp"
+#include "layout_cache.hpp"
+#include "pipeline_registry.hpp"
+#include "specialization.hpp"
+#include "vulkan_loader.hpp"
+#include "spirv_reflection.hpp"
+
+// kernel build request
+struct KernelBuildRequest {
+    std::string kernel{};
+    std::string variant{};
+    VkPipelineLayout pipelineLayout{}; // null: layout from SPIR-V reflection (layout cache)
+    SpecConstants specConstants{};     // constants of initial pipeline (workgroup size, tile parameters)
+};
+
+// kernel build result (handles are null on failure)
+struct KernelBuild {
+    std::vector<uint32_t> code{};
+    SpirvReflection reflection{};
+    KernelLayout layout{};            // reflected layout (handles owned by layout cache), pipeline layout of request otherwise
+    VkShaderModule shaderModule{};                        // owned by pipeline registry
+    std::unique_ptr<SpecializedKernel> specializations{}; // pipelines per constant values
+    PipelineFuture pipeline{};                            // pipeline with request constants (created in background)
+    SpecConstants specConstants{};                        // constants of pipeline (workgroup size of dispatch)
+    double spirvMs{};  // SPIR-V load or compilation
+    double moduleMs{}; // shader module creation
+};
+
+// build kernels on worker pool: SPIR-V compilation, reflection and shader module creation run in parallel,
+// pipelines are requested from registry with background priority and not waited for
+// (shaderc compiler and layout cache are shared, compile options are per worker thread)
+std::vector<KernelBuild> BuildKernels(ThreadPool& threadPool, PipelineRegistry& registry, const KernelCompileContext* context, LayoutCache& layoutCache,
+    const std::vector<KernelBuildRequest>& requests);
+
+// print per kernel timings
+void PrintKernelBuildTimings(const std::vector<KernelBuildRequest>& requests, const std::vector<KernelBuild>& builds, double totalMs);
+
+#ifndef VKC_NO_SHADERC
+// compile kernels at every optimization level (runtime compilation, embedded SPIR-V is ignored)
+// and print SPIR-V size and average gpu time of recorded dispatch per kernel and level
+// bind callback binds resources and records parameters of request at given index through layout of level build (once per measurement),
+// false skips measurement of level; record dispatch callback only binds and dispatches the kernel program
+void ReportKernelOptimizationLevels(ThreadPool& threadPool, VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod,
+    const KernelCompileContext& context, LayoutCache& layoutCache, const std::vector<KernelBuildRequest>& requests,
+    const std::function<bool(VkCommandBuffer, size_t requestIndex, const KernelBuild&)>& bind,
+    const std::function<void(VkCommandBuffer, size_t requestIndex, const KernelProgram&)>& recordDispatch);
+#endif
@@ -0,0 +1,110 @@
+#include "kernel_params.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// align offset up
+static VkDeviceSize AlignUp(VkDeviceSize offset, VkDeviceSize alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+// create ring
+ParameterRing::ParameterRing(VkDevice device, LayoutCache& layoutCache, const VkPhysicalDeviceLimits& limits, VkBuffer buffer, void* mappedData, VkDeviceSize size,
+    uint32_t blockSize, uint32_t framesInFlight) :
+    device(device), mappedData((uint8_t*)mappedData), alignment(std::max<VkDeviceSize>(1, limits.minUniformBufferOffsetAlignment)),
+    blockSize(blockSize), framesInFlight(std::max(1u, framesInFlight)) {
+    // frame regions start at dynamic offset alignment, any block of region can be read with full descriptor range
+    regionSize = size / this->framesInFlight / alignment * alignment;
+    if (blockSize > limits.maxUniformBufferRange || regionSize < blockSize) {
+        std::cout << "Parameter ring: " << size << " bytes are too small for " << this->framesInFlight << " frames of " << blockSize << " byte blocks" << std::endl;
+        return;
+    }
+
+    // set layout of kernel parameter set: one dynamic uniform buffer (shared with reflected kernel layouts)
+    const VkDescriptorSetLayoutBinding binding{ 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1, VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE };
+    VkDescriptorSetLayout setLayout = layoutCache.GetDescriptorSetLayout({ binding });
+    if (!setLayout) return;
+
+    // descriptor pool create info
+    const VkDescriptorPoolSize poolSize{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 };
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.pNext = VK_NULL_HANDLE;
+    descriptorPoolCreateInfo.flags = 0;
+    descriptorPoolCreateInfo.maxSets = 1;
+    descriptorPoolCreateInfo.poolSizeCount = 1;
+    descriptorPoolCreateInfo.pPoolSizes = &poolSize;
+    vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, VK_NULL_HANDLE, &descriptorPool);
+    if (!descriptorPool) return;
+
+    // descriptor set allocate info
+    VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+    descriptorSetAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptorSetAllocateInfo.pNext = VK_NULL_HANDLE;
+    descriptorSetAllocateInfo.descriptorPool = descriptorPool;
+    descriptorSetAllocateInfo.descriptorSetCount = 1;
+    descriptorSetAllocateInfo.pSetLayouts = &setLayout;
+    vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &descriptorSet);
+    if (!descriptorSet) return;
+
+    // written once, dispatches only change dynamic offset
+    VkDescriptorBufferInfo bufferInfo{ buffer, 0, blockSize };
+    VkWriteDescriptorSet writeDescriptorSet{};
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.pNext = VK_NULL_HANDLE;
+    writeDescriptorSet.dstSet = descriptorSet;
+    writeDescriptorSet.dstBinding = 0;
+    writeDescriptorSet.dstArrayElement = 0;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writeDescriptorSet.pImageInfo = VK_NULL_HANDLE;
+    writeDescriptorSet.pBufferInfo = &bufferInfo;
+    writeDescriptorSet.pTexelBufferView = VK_NULL_HANDLE;
+    vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, VK_NULL_HANDLE);
+}
+
+ParameterRing::~ParameterRing() {
+    vkDestroyDescriptorPool(device, descriptorPool, VK_NULL_HANDLE);
+}
+
+// advance to region of next frame
+void ParameterRing::NextFrame() {
+    frameIndex = (frameIndex + 1) % framesInFlight;
+    regionOffset = 0;
+}
+
+// write parameters into region of current frame
+uint32_t ParameterRing::Write(const void* data, uint32_t size) {
+    // block must fit region with full descriptor range behind its offset
+    if (!descriptorSet || size > blockSize || regionOffset + blockSize > regionSize) return UINT32_MAX;
+    const VkDeviceSize offset = frameIndex * regionSize + regionOffset;
+    memcpy(mappedData + offset, data, size);
+    regionOffset = AlignUp(regionOffset + size, alignment);
+    writeCount++;
+    return (uint32_t)offset;
+}
+
+// kernel parameter binding
+KernelParams::KernelParams(const SpirvReflection& reflection, const KernelLayout& layout, ParameterRing* ring) :
+    pipelineLayout(layout.pipelineLayout), pushConstantSize(layout.pushConstantRange.size), ring(ring) {
+    for (const auto& binding : reflection.bindings)
+        if (binding.set == KernelParamsSet && binding.binding == 0 && binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+            spilled = true;
+}
+
+// record parameters
+bool KernelParams::Record(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const {
+    // push constants: size must match kernel parameter block
+    if (pushConstantSize) {
+        if (size != pushConstantSize) return false;
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, size, data);
+        return true;
+    }
+    // spilled: block in parameter ring bound with dynamic offset
+    if (!spilled || !ring) return false;
+    const uint32_t offset = ring->Write(data, size);
+    if (offset == UINT32_MAX) return false;
+    VkDescriptorSet descriptorSet = ring->GetDescriptorSet();
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, KernelParamsSet, 1, &descriptorSet, 1, &offset);
+    return true;
+}
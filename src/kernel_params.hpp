@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "vulkan_loader.hpp"
+#include "layout_cache.hpp"
+#include "spirv_reflection.hpp"
+
+// guaranteed minimum of VkPhysicalDeviceLimits::maxPushConstantsSize
+constexpr uint32_t MinMaxPushConstantsSize = 128;
+
+// check parameters fit push constants of every device (compile time)
+template <typename T>
+constexpr bool FitsPushConstants() { return sizeof(T) <= MinMaxPushConstantsSize; }
+
+// check parameters fit push constants of device
+template <typename T>
+bool FitsPushConstants(const VkPhysicalDeviceLimits& limits) { return FitsPushConstants<T>() || sizeof(T) <= limits.maxPushConstantsSize; }
+
+// uniform buffer ring of kernel parameters that do not fit push constants
+// buffer is host visible and coherent, persistently mapped by caller and split into one region per frame in flight,
+// parameters are bound through one dynamic uniform buffer descriptor, so a dispatch changes only its dynamic offset
+class ParameterRing {
+public:
+    // block size is the descriptor range (largest parameter block), buffer must hold framesInFlight regions
+    ParameterRing(VkDevice device, LayoutCache& layoutCache, const VkPhysicalDeviceLimits& limits, VkBuffer buffer, void* mappedData, VkDeviceSize size,
+        uint32_t blockSize, uint32_t framesInFlight);
+    ~ParameterRing();
+    ParameterRing(const ParameterRing&) = delete;
+    ParameterRing& operator=(const ParameterRing&) = delete;
+    // advance to region of next frame (caller ensures frame submitted framesInFlight frames ago finished)
+    void NextFrame();
+    // write parameters into region of current frame, returns dynamic offset, UINT32_MAX when region is full or block is too large
+    uint32_t Write(const void* data, uint32_t size);
+    // get descriptor set (KernelParamsSet), null on failure
+    VkDescriptorSet GetDescriptorSet() const { return descriptorSet; }
+    // get count of written blocks
+    uint64_t GetWriteCount() const { return writeCount; }
+private:
+    VkDevice device{};
+    VkDescriptorPool descriptorPool{};
+    VkDescriptorSet descriptorSet{};
+    uint8_t* mappedData{};
+    VkDeviceSize regionSize{};
+    VkDeviceSize alignment{};
+    uint32_t blockSize{};
+    uint32_t framesInFlight{};
+    uint32_t frameIndex{};
+    VkDeviceSize regionOffset{}; // write offset within current region
+    uint64_t writeCount{};
+};
+
+// kernel parameter binding: push constants when kernel declares them, spill to parameter ring otherwise
+class KernelParams {
+public:
+    // ring may be null for kernels without spilled parameters
+    KernelParams(const SpirvReflection& reflection, const KernelLayout& layout, ParameterRing* ring);
+    // check kernel takes parameters through push constants
+    bool UsesPushConstants() const { return pushConstantSize != 0; }
+    // check kernel takes parameters through parameter ring
+    bool UsesRing() const { return spilled; }
+    // record parameters, returns false when size does not match kernel or ring is full
+    bool Record(VkCommandBuffer commandBuffer, const void* data, uint32_t size) const;
+    // record typed parameters (std140 host struct of kernel parameter block)
+    template <typename T>
+    bool Record(VkCommandBuffer commandBuffer, const T& params) const {
+        static_assert(std::is_trivially_copyable_v<T>, "kernel parameters must be trivially copyable");
+        static_assert(sizeof(T) % 4 == 0, "kernel parameter size must be multiple of 4");
+        return Record(commandBuffer, &params, sizeof(T));
+    }
+private:
+    VkPipelineLayout pipelineLayout{};
+    uint32_t pushConstantSize{};
+    bool spilled{};
+    ParameterRing* ring{};
+};
@@ -0,0 +1,75 @@
+#include "kernels.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#ifndef VKC_NO_SHADERC
+#include "shader_cache.hpp"
+#endif
+
+// embedded kernels (generated by build/mingw/Makefile)
+#ifdef VKC_EMBEDDED_KERNELS
+#include "embedded_kernels.inc"
+#define KERNEL_CODE(kernel, variant) spv_##kernel##_##variant, sizeof(spv_##kernel##_##variant) / sizeof(uint32_t)
+#else
+#define KERNEL_CODE(kernel, variant) nullptr, 0
+#endif
+
+// kernel variants table (generated by build/mingw/Makefile)
+static const KernelVariant kernelVariants[] = {
+#define KERNEL_VARIANT(kernel, variant, defines) { #kernel, #variant, defines, KERNEL_CODE(kernel, variant) },
+#include "kernel_variants.inc"
+#undef KERNEL_VARIANT
+};
+#undef KERNEL_CODE
+
+// find kernel variant
+const KernelVariant* FindKernelVariant(const char* kernel, const char* variant) {
+    for (const auto& kernelVariant : kernelVariants)
+        if (strcmp(kernelVariant.kernel, kernel) == 0 && strcmp(kernelVariant.variant, variant) == 0)
+            return &kernelVariant;
+    return nullptr;
+}
+
+// load kernel source text
+std::string LoadKernelSource(const std::filesystem::path& directory, const char* kernel) {
+    std::ifstream file(directory / (std::string(kernel) + ".comp"));
+    std::stringstream source{};
+    source << file.rdbuf();
+    return source.str();
+}
+
+// get kernel variant SPIR-V
+std::vector<uint32_t> GetKernelSpirv(const KernelCompileContext* context, const char* kernel, const char* variant) {
+    const KernelVariant* kernelVariant = FindKernelVariant(kernel, variant);
+    if (!kernelVariant) {
+        std::cout << "Unknown kernel variant " << kernel << "." << variant << std::endl;
+        return {};
+    }
+
+    // embedded SPIR-V: no runtime compilation at all
+    if (kernelVariant->code && (!context || context->preferEmbedded))
+        return std::vector<uint32_t>(kernelVariant->code, kernelVariant->code + kernelVariant->codeSize);
+
+#ifndef VKC_NO_SHADERC
+    // runtime compilation from kernel source directory
+    if (context && context->compiler) {
+        const std::string source = LoadKernelSource(context->directory, kernel);
+        if (source.empty()) {
+            std::cout << "Kernel source " << kernel << ".comp not found in " << context->directory << std::endl;
+            return {};
+        }
+        ShaderCompileOptions options = context->options ? *context->options : ShaderCompileOptions{};
+        std::istringstream defines(kernelVariant->defines);
+        for (std::string define{}; defines >> define;) {
+            const size_t separator = define.find('=');
+            options.macros.emplace_back(define.substr(0, separator), separator == std::string::npos ? "" : define.substr(separator + 1));
+        }
+        // source path as shader name: diagnostics and "file" includes relative to kernel
+        const std::string name = (context->directory / (std::string(kernel) + ".comp")).generic_string();
+        return GetComputeShaderSpirv(context->cache, *context->compiler, source, name.c_str(), options);
+    }
+#endif
+    std::cout << "Kernel " << kernel << "." << variant << " is not embedded and runtime compilation is not available" << std::endl;
+    return {};
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+class SpirvCache;
+class ShaderCompiler;
+struct ShaderCompileOptions;
+
+// kernel variant, variants are declared in build/mingw/Makefile (SHADER_VARIANTS)
+struct KernelVariant {
+    const char* kernel{};
+    const char* variant{};
+    const char* defines{};      // macro definitions "NAME=VALUE ..."
+    const uint32_t* code{};     // embedded SPIR-V (null when kernels are not embedded)
+    size_t codeSize{};          // in words
+};
+
+// runtime kernel compilation context (development builds)
+struct KernelCompileContext {
+    std::filesystem::path directory{};  // kernel sources directory (<kernel>.comp)
+    SpirvCache* cache{};
+    ShaderCompiler* compiler{};
+    const ShaderCompileOptions* options{};  // base compile options, variant defines are added (null means defaults)
+    bool preferEmbedded = true;             // use embedded SPIR-V when available
+};
+
+// find kernel variant, returns null if variant is unknown
+const KernelVariant* FindKernelVariant(const char* kernel, const char* variant);
+
+// load kernel source text, returns empty string if not found
+std::string LoadKernelSource(const std::filesystem::path& directory, const char* kernel);
+
+// get kernel variant SPIR-V: embedded code first, then SPIR-V cache or runtime compilation
+// context may be null (and is ignored in builds without shaderc), returns empty code on failure
+std::vector<uint32_t> GetKernelSpirv(const KernelCompileContext* context, const char* kernel, const char* variant);
@@ -0,0 +1,220 @@
+#include "layout_cache.hpp"
+#include "descriptor_update.hpp"
+#include "hash.hpp"
+#include <algorithm>
+
+// append raw value bytes to layout key
+template <typename T>
+static void AppendKey(std::string& key, const T& value) {
+    key.append((const char*)&value, sizeof(T));
+}
+
+LayoutCache::~LayoutCache() {
+    for (const auto& [key, updateTemplate] : updateTemplates)
+        vkDestroyDescriptorUpdateTemplate(device, updateTemplate, VK_NULL_HANDLE);
+    for (const auto& [key, pipelineLayout] : pipelineLayouts)
+        vkDestroyPipelineLayout(device, pipelineLayout, VK_NULL_HANDLE);
+    for (const auto& [key, descriptorSetLayout] : descriptorSetLayouts)
+        vkDestroyDescriptorSetLayout(device, descriptorSetLayout, VK_NULL_HANDLE);
+}
+
+// key of set layout bindings sorted by binding number (immutable samplers are not supported)
+static std::string GetSetLayoutKey(std::vector<VkDescriptorSetLayoutBinding>& sortedBindings, VkDescriptorSetLayoutCreateFlags flags) {
+    std::sort(sortedBindings.begin(), sortedBindings.end(), [](const auto& a, const auto& b) { return a.binding < b.binding; });
+    std::string key{};
+    AppendKey(key, flags);
+    for (const auto& binding : sortedBindings) {
+        AppendKey(key, binding.binding);
+        AppendKey(key, binding.descriptorType);
+        AppendKey(key, binding.descriptorCount);
+        AppendKey(key, binding.stageFlags);
+    }
+    return key;
+}
+
+// get descriptor set layout
+VkDescriptorSetLayout LayoutCache::GetDescriptorSetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags) {
+    std::vector<VkDescriptorSetLayoutBinding> sortedBindings = bindings;
+    std::string key = GetSetLayoutKey(sortedBindings, flags);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = descriptorSetLayouts.find(key);
+    if (cached != descriptorSetLayouts.end()) return cached->second;
+
+    // descriptor set layout create info
+    VkDescriptorSetLayoutCreateInfo descSetLayoutCreateInfo{};
+    descSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descSetLayoutCreateInfo.pNext = VK_NULL_HANDLE;
+    descSetLayoutCreateInfo.flags = flags;
+    descSetLayoutCreateInfo.bindingCount = (uint32_t)sortedBindings.size();
+    descSetLayoutCreateInfo.pBindings = sortedBindings.data();
+    // create descriptor set layout
+    VkDescriptorSetLayout descSetLayout{};
+    vkCreateDescriptorSetLayout(device, &descSetLayoutCreateInfo, VK_NULL_HANDLE, &descSetLayout);
+    if (descSetLayout) descriptorSetLayouts.emplace(std::move(key), descSetLayout);
+    return descSetLayout;
+}
+
+// get descriptor update template of set layout
+VkDescriptorUpdateTemplate LayoutCache::GetDescriptorUpdateTemplate(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags,
+    VkPipelineLayout pipelineLayout, uint32_t set) {
+    if (bindings.empty()) return VK_NULL_HANDLE;
+    const bool pushDescriptors = flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    if (pushDescriptors && !pipelineLayout) return VK_NULL_HANDLE;
+    VkDescriptorSetLayout setLayout = GetDescriptorSetLayout(bindings, flags);
+    if (!setLayout) return VK_NULL_HANDLE;
+    std::vector<VkDescriptorSetLayoutBinding> sortedBindings = bindings;
+    std::string key = GetSetLayoutKey(sortedBindings, flags);
+    if (pushDescriptors) {
+        AppendKey(key, pipelineLayout);
+        AppendKey(key, set);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = updateTemplates.find(key);
+    if (cached != updateTemplates.end()) return cached->second;
+
+    // descriptor update template create info (packed DescriptorInfo per descriptor)
+    std::vector<VkDescriptorUpdateTemplateEntry> entries = GetDescriptorTemplateEntries(sortedBindings);
+    VkDescriptorUpdateTemplateCreateInfo updateTemplateCreateInfo{};
+    updateTemplateCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    updateTemplateCreateInfo.pNext = VK_NULL_HANDLE;
+    updateTemplateCreateInfo.flags = 0;
+    updateTemplateCreateInfo.descriptorUpdateEntryCount = (uint32_t)entries.size();
+    updateTemplateCreateInfo.pDescriptorUpdateEntries = entries.data();
+    updateTemplateCreateInfo.templateType = pushDescriptors ? VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR : VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    updateTemplateCreateInfo.descriptorSetLayout = setLayout;
+    updateTemplateCreateInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+    updateTemplateCreateInfo.pipelineLayout = pushDescriptors ? pipelineLayout : VK_NULL_HANDLE;
+    updateTemplateCreateInfo.set = pushDescriptors ? set : 0;
+    // create descriptor update template
+    VkDescriptorUpdateTemplate updateTemplate{};
+    vkCreateDescriptorUpdateTemplate(device, &updateTemplateCreateInfo, VK_NULL_HANDLE, &updateTemplate);
+    if (updateTemplate) {
+        updateTemplates.emplace(std::move(key), updateTemplate);
+        updateTemplateDataSizes.emplace(updateTemplate, GetDescriptorTemplateDataSize(entries));
+    }
+    return updateTemplate;
+}
+
+// get size of data read by descriptor update template
+size_t LayoutCache::GetDescriptorUpdateTemplateDataSize(VkDescriptorUpdateTemplate updateTemplate) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = updateTemplateDataSizes.find(updateTemplate);
+    return cached != updateTemplateDataSizes.end() ? cached->second : 0;
+}
+
+// get pipeline layout
+VkPipelineLayout LayoutCache::GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<VkPushConstantRange>& pushConstantRanges) {
+    std::string key{};
+    for (VkDescriptorSetLayout setLayout : setLayouts)
+        AppendKey(key, setLayout);
+    for (const auto& pushConstantRange : pushConstantRanges)
+        AppendKey(key, pushConstantRange);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = pipelineLayouts.find(key);
+    if (cached != pipelineLayouts.end()) return cached->second;
+
+    // pipeline layout create info
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.pNext = VK_NULL_HANDLE;
+    pipelineLayoutCreateInfo.flags = 0;
+    pipelineLayoutCreateInfo.setLayoutCount = (uint32_t)setLayouts.size();
+    pipelineLayoutCreateInfo.pSetLayouts = setLayouts.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = (uint32_t)pushConstantRanges.size();
+    pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
+    // create pipeline layout
+    VkPipelineLayout pipelineLayout{};
+    vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, VK_NULL_HANDLE, &pipelineLayout);
+    if (pipelineLayout) pipelineLayouts.emplace(std::move(key), pipelineLayout);
+    return pipelineLayout;
+}
+
+// get descriptor set layout bindings of kernel per set number
+std::vector<std::vector<VkDescriptorSetLayoutBinding>> GetKernelSetBindings(const SpirvReflection& reflection) {
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> setBindings{};
+    for (const auto& binding : reflection.bindings) {
+        if (binding.set >= setBindings.size()) setBindings.resize(binding.set + 1);
+        // runtime sized arrays have no count in SPIR-V, bound as single descriptor
+        // spilled kernel parameters are dynamic uniform buffers (same set layout as parameter ring),
+        // bindless set bindings are reflected only (set layout of BindlessDescriptors)
+        VkDescriptorType descriptorType = binding.descriptorType;
+        if (binding.set == KernelParamsSet && descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+        setBindings[binding.set].push_back({ binding.binding, descriptorType, std::max(1u, binding.descriptorCount), VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE });
+    }
+    return setBindings;
+}
+
+// get set pushed with push descriptors: first resource set within push descriptor limit
+// (one push set per pipeline layout, dynamic buffers of parameter set can't be pushed)
+static uint32_t SelectPushDescriptorSet(const std::vector<std::vector<VkDescriptorSetLayoutBinding>>& setBindings, uint32_t maxPushDescriptors) {
+    for (uint32_t set = 0; set < setBindings.size(); set++) {
+        if (set == KernelParamsSet || set == BindlessSet || setBindings[set].empty()) continue;
+        uint32_t descriptorCount = 0;
+        bool dynamic = false;
+        for (const auto& binding : setBindings[set]) {
+            descriptorCount += binding.descriptorCount;
+            dynamic |= binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+        }
+        if (!dynamic && descriptorCount <= maxPushDescriptors) return set;
+    }
+    return UINT32_MAX;
+}
+
+// get kernel layout from reflection
+KernelLayout LayoutCache::GetKernelLayout(const SpirvReflection& reflection) {
+    KernelLayout layout{};
+
+    // sets without bindings below highest used set get empty layouts
+    // descriptor buffers: all set layouts of pipeline layout are descriptor buffer layouts (empty ones too)
+    std::vector<std::vector<VkDescriptorSetLayoutBinding>> setBindings = GetKernelSetBindings(reflection);
+    std::vector<VkDescriptorSetLayoutCreateFlags> setFlags(setBindings.size(), descriptorBuffer ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT : 0);
+    layout.pushDescriptorSet = descriptorBuffer ? UINT32_MAX : SelectPushDescriptorSet(setBindings, maxPushDescriptors);
+    if (layout.pushDescriptorSet != UINT32_MAX) setFlags[layout.pushDescriptorSet] = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+    if (descriptorBuffer) layout.pipelineFlags = VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+    for (size_t set = 0; set < setBindings.size(); set++) {
+        const bool bindless = set == BindlessSet && !setBindings[set].empty();
+        VkDescriptorSetLayout setLayout = bindless ? bindlessSetLayout : GetDescriptorSetLayout(setBindings[set], setFlags[set]);
+        if (!setLayout) return layout;
+        layout.setLayouts.push_back(setLayout);
+    }
+
+    // push constant range
+    std::vector<VkPushConstantRange> pushConstantRanges{};
+    if (reflection.pushConstantSize) {
+        layout.pushConstantRange = { VK_SHADER_STAGE_COMPUTE_BIT, 0, reflection.pushConstantSize };
+        pushConstantRanges.push_back(layout.pushConstantRange);
+    }
+    layout.pipelineLayout = GetPipelineLayout(layout.setLayouts, pushConstantRanges);
+
+    // content hash: handles differ per process, persistent keys (shader binaries) use layout content
+    Hasher hasher{};
+    hasher.AddValue(layout.pipelineFlags).AddValue(layout.pushConstantRange).AddValue((uint64_t)setBindings.size());
+    for (size_t set = 0; set < setBindings.size(); set++) {
+        hasher.AddValue(setFlags[set]).AddValue((uint32_t)(set == BindlessSet && !setBindings[set].empty())).AddValue((uint64_t)setBindings[set].size());
+        for (const auto& binding : setBindings[set])
+            hasher.AddValue(binding.binding).AddValue(binding.descriptorType).AddValue(binding.descriptorCount).AddValue(binding.stageFlags);
+    }
+    layout.contentHash = hasher.value;
+
+    // update templates (push template refers to pipeline layout, bindless set is written per slot, descriptor buffer sets by vkGetDescriptorEXT)
+    if (!layout.pipelineLayout) return layout;
+    for (uint32_t set = 0; set < setBindings.size(); set++) {
+        layout.updateTemplates.push_back(set == BindlessSet || descriptorBuffer ? VK_NULL_HANDLE : GetDescriptorUpdateTemplate(setBindings[set], setFlags[set], layout.pipelineLayout, set));
+        layout.updateTemplateDataSizes.push_back(GetDescriptorUpdateTemplateDataSize(layout.updateTemplates.back()));
+    }
+    return layout;
+}
+
+// get count of created layouts
+size_t LayoutCache::GetDescriptorSetLayoutCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return descriptorSetLayouts.size();
+}
+
+size_t LayoutCache::GetPipelineLayoutCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pipelineLayouts.size();
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "vulkan_loader.hpp"
+#include "spirv_reflection.hpp"
+
+// descriptor set of kernel parameters spilled from push constants (shaders/include/params.glsl),
+// its uniform buffer is bound with dynamic offset into parameter ring
+constexpr uint32_t KernelParamsSet = 1;
+
+// descriptor set of bindless resources (shaders/include/bindless.glsl), its layout is owned by BindlessDescriptors
+// and shared by every kernel using it
+constexpr uint32_t BindlessSet = 2;
+
+// kernel layout (handles are owned by layout cache)
+struct KernelLayout {
+    std::vector<VkDescriptorSetLayout> setLayouts{}; // indexed by set number, unused sets get empty layouts
+    std::vector<VkDescriptorUpdateTemplate> updateTemplates{}; // per set (DescriptorSetData order), null for empty sets
+    std::vector<size_t> updateTemplateDataSizes{};             // per set, bytes of packed data read by update template (zero without template)
+    VkPipelineLayout pipelineLayout{};
+    VkPushConstantRange pushConstantRange{};          // zero size when kernel has no push constants
+    uint32_t pushDescriptorSet = UINT32_MAX;          // set recorded with push descriptors (its template pushes), UINT32_MAX when none
+    VkPipelineCreateFlags pipelineFlags{};            // VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT for descriptor buffer set layouts
+    uint64_t contentHash{};                           // set bindings and flags, push constant range and pipeline flags (same in every process), zero for explicit layouts
+};
+
+// get descriptor set layout bindings of kernel per set number (compute stage, sets without bindings are empty)
+std::vector<std::vector<VkDescriptorSetLayoutBinding>> GetKernelSetBindings(const SpirvReflection& reflection);
+
+// descriptor set and pipeline layout cache: identical layouts are created once and shared by kernels,
+// so kernels with the same layout can share descriptor sets and need no rebinding (thread safe)
+// with maxPushDescriptors (VK_KHR_push_descriptor) resource set of kernel layouts is a push descriptor set,
+// kernels with bindings in BindlessSet get bindless set layout (kernel layout fails without it),
+// with descriptorBuffer (VK_EXT_descriptor_buffer) every set layout of kernel layouts is a descriptor buffer layout without templates
+class LayoutCache {
+public:
+    explicit LayoutCache(VkDevice device, uint32_t maxPushDescriptors = 0, VkDescriptorSetLayout bindlessSetLayout = VK_NULL_HANDLE, bool descriptorBuffer = false) :
+        device(device), maxPushDescriptors(maxPushDescriptors), bindlessSetLayout(bindlessSetLayout), descriptorBuffer(descriptorBuffer) {}
+    ~LayoutCache();
+    LayoutCache(const LayoutCache&) = delete;
+    LayoutCache& operator=(const LayoutCache&) = delete;
+    // get descriptor set layout, returns null on failure
+    VkDescriptorSetLayout GetDescriptorSetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0);
+    // get descriptor update template of set layout with packed DescriptorSetData entries, returns null on failure
+    // (push descriptor set layouts get push template of set number in pipeline layout)
+    VkDescriptorUpdateTemplate GetDescriptorUpdateTemplate(const std::vector<VkDescriptorSetLayoutBinding>& bindings, VkDescriptorSetLayoutCreateFlags flags = 0,
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t set = 0);
+    // get size of packed data read by descriptor update template created by cache, zero for unknown templates
+    size_t GetDescriptorUpdateTemplateDataSize(VkDescriptorUpdateTemplate updateTemplate);
+    // get pipeline layout, returns null on failure
+    VkPipelineLayout GetPipelineLayout(const std::vector<VkDescriptorSetLayout>& setLayouts, const std::vector<VkPushConstantRange>& pushConstantRanges);
+    // get kernel layout from reflection (compute stage only), pipeline layout is null on failure
+    KernelLayout GetKernelLayout(const SpirvReflection& reflection);
+    // get count of created layouts
+    size_t GetDescriptorSetLayoutCount();
+    size_t GetPipelineLayoutCount();
+private:
+    VkDevice device{};
+    uint32_t maxPushDescriptors{};                                        // zero: push descriptors disabled
+    VkDescriptorSetLayout bindlessSetLayout{};                            // not owned
+    bool descriptorBuffer{};
+    std::mutex mutex{};
+    std::map<std::string, VkDescriptorSetLayout> descriptorSetLayouts{}; // key: flags and bindings
+    std::map<std::string, VkDescriptorUpdateTemplate> updateTemplates{}; // key: flags and bindings (and pipeline layout and set of push templates)
+    std::map<VkDescriptorUpdateTemplate, size_t> updateTemplateDataSizes{}; // bytes of packed data read by template
+    std::map<std::string, VkPipelineLayout> pipelineLayouts{};           // key: set layouts and push constant ranges
+};
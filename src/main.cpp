@@ -1,44 +1,121 @@
 #include <vector>
+#include <memory>
+#include <thread>
+#include <algorithm>
 #include <cstring>
+#include <cstdlib>
 #include <cassert>
 #include <iostream>
+#include "vulkan_loader.hpp"
 #include <vma/VmaUsage.h>
-#include <shaderc/shaderc.h>
+#include "options.hpp"
+#include "device_select.hpp"
+#include "queues.hpp"
+#include "capabilities.hpp"
+#include "profile.hpp"
+#include "bench.hpp"
+#include "kernels.hpp"
+#include "kernel_builder.hpp"
+#include "layout_cache.hpp"
+#include "pipeline_cache.hpp"
+#include "tuning.hpp"
+#include "kernel_params.hpp"
+#include "descriptor_allocator.hpp"
+#include "bindless_descriptors.hpp"
+#include "descriptor_buffer.hpp"
+#include "kernel_args.hpp"
+#include "staging_ring.hpp"
+#include "readback.hpp"
+#ifndef VKC_NO_SHADERC
+#include "shader_cache.hpp"
+#endif
 
-// compute shader image write
-const char* computeShader_ImageWrite = R"(
-    #version 450
-    struct SolidColor { vec4 color; };
+// get VMA functions from dispatch table
+VmaVulkanFunctions GetVmaVulkanFunctions() {
+    VmaVulkanFunctions vulkanFunctions{};
+    vulkanFunctions.vkGetInstanceProcAddr = vkGetInstanceProcAddr;
+    vulkanFunctions.vkGetDeviceProcAddr = vkGetDeviceProcAddr;
+    vulkanFunctions.vkGetPhysicalDeviceProperties = vkGetPhysicalDeviceProperties;
+    vulkanFunctions.vkGetPhysicalDeviceMemoryProperties = vkGetPhysicalDeviceMemoryProperties;
+    vulkanFunctions.vkAllocateMemory = vkAllocateMemory;
+    vulkanFunctions.vkFreeMemory = vkFreeMemory;
+    vulkanFunctions.vkMapMemory = vkMapMemory;
+    vulkanFunctions.vkUnmapMemory = vkUnmapMemory;
+    vulkanFunctions.vkFlushMappedMemoryRanges = vkFlushMappedMemoryRanges;
+    vulkanFunctions.vkInvalidateMappedMemoryRanges = vkInvalidateMappedMemoryRanges;
+    vulkanFunctions.vkBindBufferMemory = vkBindBufferMemory;
+    vulkanFunctions.vkBindImageMemory = vkBindImageMemory;
+    vulkanFunctions.vkGetBufferMemoryRequirements = vkGetBufferMemoryRequirements;
+    vulkanFunctions.vkGetImageMemoryRequirements = vkGetImageMemoryRequirements;
+    vulkanFunctions.vkCreateBuffer = vkCreateBuffer;
+    vulkanFunctions.vkDestroyBuffer = vkDestroyBuffer;
+    vulkanFunctions.vkCreateImage = vkCreateImage;
+    vulkanFunctions.vkDestroyImage = vkDestroyImage;
+    vulkanFunctions.vkCmdCopyBuffer = vkCmdCopyBuffer;
+    vulkanFunctions.vkGetBufferMemoryRequirements2KHR = vkGetBufferMemoryRequirements2;
+    vulkanFunctions.vkGetImageMemoryRequirements2KHR = vkGetImageMemoryRequirements2;
+    vulkanFunctions.vkBindBufferMemory2KHR = vkBindBufferMemory2;
+    vulkanFunctions.vkBindImageMemory2KHR = vkBindImageMemory2;
+    vulkanFunctions.vkGetPhysicalDeviceMemoryProperties2KHR = vkGetPhysicalDeviceMemoryProperties2;
+    vulkanFunctions.vkGetDeviceBufferMemoryRequirements = vkGetDeviceBufferMemoryRequirements;
+    vulkanFunctions.vkGetDeviceImageMemoryRequirements = vkGetDeviceImageMemoryRequirements;
+    return vulkanFunctions;
+}
 
-    layout(set = 0, binding = 0, rgba8ui) uniform readonly  uimage2D inputImage;
-    layout(set = 0, binding = 1, rgba8ui) uniform writeonly uimage2D outputImage;
-    layout(set = 0, binding = 2, std140)  uniform ubo2 { SolidColor uSolidColor0; };
+// storage images of image_write set 0 (packed update template data, members in binding order)
+struct ImageWriteDescriptors {
+    VkDescriptorImageInfo inputImage{};
+    VkDescriptorImageInfo outputImage{};
+};
 
-    layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
-    void main() {
-        return;
-    }
-)";
-
-// compile compute shader
-shaderc_compilation_result_t CompileComputeShader(shaderc_compiler_t compiler, std::string_view source) {
-    shaderc_compilation_result_t result = shaderc_compile_into_spv(compiler, source.data(), source.size(), shaderc_glsl_default_compute_shader, "Compute shader", "main", nullptr);
-    if (shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success) return result;
-    std::cout << "Shader compiler: " << shaderc_result_get_error_message(result) << std::endl;
-    shaderc_result_release(result);
-    return nullptr;
-}
+// per dispatch parameters of image_write (std140 parameter block of shaders/image_write.comp)
+struct ImageWriteParams {
+    float solidColor[4]{ 1.0f, 0.0f, 1.0f, 1.0f };
+};
+
+// per dispatch parameters of image_write bindless variant: bindless slot of batch table and batch item count
+struct ImageWriteBatchParams {
+    float solidColor[4]{ 1.0f, 0.0f, 1.0f, 1.0f };
+    uint32_t batchTable{};
+    uint32_t batchCount{};
+};
+
+// batch table item of image_write bindless variant (std430 BatchItem): bindless storage image slots and image size
+struct ImageWriteBatchItem {
+    uint32_t inputImage{};
+    uint32_t outputImage{};
+    uint32_t width{};
+    uint32_t height{};
+};
+
+// kernel arguments of buffer_fill (KERNEL_ARGS block of shaders/buffer_fill.comp): device address of pixels, pixel count and packed rgba8 color
+struct BufferFillArgs {
+    DevicePointer<uint32_t> pixels{};
+    uint32_t pixelCount{};
+    uint32_t packedColor = 0xffff00ff;
+};
+static const KernelArgMember bufferFillArgMembers[]{
+    KERNEL_ARG(BufferFillArgs, pixels),
+    KERNEL_ARG(BufferFillArgs, pixelCount),
+    KERNEL_ARG(BufferFillArgs, packedColor)
+};
 
 int main(int argc, char** argv) {
+    // load vulkan library
+    if (!LoadVulkanLibrary()) {
+        std::cout << "Vulkan library not found" << std::endl;
+        return 1;
+    }
+
+    // runtime profile (--profile=release|debug|gpu-assisted|best-practices or VKC_PROFILE)
+    RuntimeProfileSettings profileSettings = GetRuntimeProfileSettings(ParseRuntimeProfile(GetOption(argc, argv, "--profile", "VKC_PROFILE")));
+    std::cout << "Runtime profile: " << GetRuntimeProfileName(profileSettings.profile) << std::endl;
+
     // vulkan extensions
-    std::vector<const char *> enabledInstanceLayerNames{ "VK_LAYER_KHRONOS_validation" };
-    std::vector<const char *> enabledInstanceExtensionNames{ VK_EXT_DEBUG_UTILS_EXTENSION_NAME };
-    std::vector<const char *> enabledDeviceLayerNames{ "VK_LAYER_KHRONOS_validation" };
-    std::vector<const char *> enabledDeviceExtensionNames{ 
-        VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
-        VK_KHR_ACCELERATION_STRUCTURE_EXTENSION_NAME,
-        VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME
-    };
+    std::vector<const char *> enabledInstanceLayerNames = profileSettings.layers;
+    std::vector<const char *> enabledInstanceExtensionNames = profileSettings.instanceExtensions;
+    std::vector<const char *> enabledDeviceLayerNames = profileSettings.layers;
+    std::vector<const char *> enabledDeviceExtensionNames{};
 
     // get vulkan instance version
     uint32_t instanceVersion{};
@@ -60,7 +137,7 @@ int main(int argc, char** argv) {
     // instance create info
     VkInstanceCreateInfo instanceCreateInfo{};
     instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
-    instanceCreateInfo.pNext = VK_NULL_HANDLE;
+    instanceCreateInfo.pNext = profileSettings.GetInstancePNext();
     instanceCreateInfo.flags = 0;
     instanceCreateInfo.pApplicationInfo = &applicationInfo;
     instanceCreateInfo.enabledLayerCount = enabledInstanceLayerNames.size();
@@ -71,187 +148,288 @@ int main(int argc, char** argv) {
     VkInstance instance{};
     vkCreateInstance(&instanceCreateInfo, VK_NULL_HANDLE, &instance);
     assert(instance);
+    LoadVulkanInstance(instance);
 
-    // get physical devices
-    uint32_t physicalDevicesCount{};
-    vkEnumeratePhysicalDevices(instance, &physicalDevicesCount, VK_NULL_HANDLE);
-    std::vector<VkPhysicalDevice> physicalDevices(physicalDevicesCount);
-    vkEnumeratePhysicalDevices(instance, &physicalDevicesCount, physicalDevices.data());
-
-    // VK_EXT_DEBUG_UTILS_EXTENSION_NAME
-    VkDebugUtilsMessengerCreateInfoEXT messengerCreateInfo{};
-    messengerCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
-    messengerCreateInfo.messageSeverity = 
-        VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT |
-        VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
-        VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
-    messengerCreateInfo.messageType = 
-        VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
-        VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
-        VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
-    messengerCreateInfo.pfnUserCallback = [](
-        VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
-        VkDebugUtilsMessageTypeFlagsEXT messageType,
-        const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
-        void* pUserData) { std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl; return VK_FALSE; };
-    messengerCreateInfo.pUserData = nullptr;
-    VkDebugUtilsMessengerEXT debugUtilsMessengerEXT{};
-    auto fnCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
-    if (fnCreateDebugUtilsMessengerEXT != nullptr)
-        fnCreateDebugUtilsMessengerEXT(instance, &messengerCreateInfo, VK_NULL_HANDLE, &debugUtilsMessengerEXT);
-
-    // physical device features
-    uint32_t queueFamilyIndex = 0;
-    VkPhysicalDeviceFeatures physicalDeviceFeatures{};
-    physicalDeviceFeatures.shaderInt16 = VK_TRUE;
-    physicalDeviceFeatures.shaderInt64 = VK_TRUE;
-    // device queue create info
-    float queuePriorities = 1.0f;
-    VkDeviceQueueCreateInfo deviceQueueCreateInfo{};
-    deviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    deviceQueueCreateInfo.pNext = VK_NULL_HANDLE;
-    deviceQueueCreateInfo.flags = 0;
-    deviceQueueCreateInfo.queueFamilyIndex = queueFamilyIndex;
-    deviceQueueCreateInfo.queueCount = 1;
-    deviceQueueCreateInfo.pQueuePriorities = &queuePriorities;
+    // debug messenger (not installed in release profile)
+    VkDebugUtilsMessengerEXT debugUtilsMessengerEXT = CreateDebugMessenger(instance, profileSettings);
+
+    // select physical device and queue family (override: --device=<index|name> or VKC_DEVICE)
+    PhysicalDeviceInfo physicalDeviceInfo = SelectPhysicalDevice(instance, GetOption(argc, argv, "--device", "VKC_DEVICE"));
+    assert(physicalDeviceInfo.physicalDevice);
+    VkPhysicalDevice physicalDevice = physicalDeviceInfo.physicalDevice;
+    // discover dedicated compute and transfer queue families
+    QueueFamilies queueFamilies = FindQueueFamilies(physicalDeviceInfo.queueFamilies, physicalDeviceInfo.computeQueueFamilyIndex);
+    std::vector<uint32_t> queueFamilyIndices = GetUniqueQueueFamilies(queueFamilies);
+    std::cout << "Queue families: universal " << queueFamilies.universal;
+    std::cout << ", compute " << queueFamilies.compute << ", transfer " << queueFamilies.transfer << std::endl;
+
+    // negotiate device features and optional extensions
+    DeviceFeatureChain enabledDeviceFeatures{};
+    DeviceCapabilities capabilities = NegotiateDeviceCapabilities(physicalDevice, enabledDeviceFeatures, enabledDeviceExtensionNames);
+    PrintDeviceCapabilities(capabilities);
+    // device queue create infos
+    const float queuePriorities[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfos = BuildQueueCreateInfos(queueFamilies, queuePriorities);
     // device create info
     VkDeviceCreateInfo deviceCreateInfo{};
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    deviceCreateInfo.pNext = VK_NULL_HANDLE;
+    deviceCreateInfo.pNext = &enabledDeviceFeatures.features2;
     deviceCreateInfo.flags = 0;
-    deviceCreateInfo.queueCreateInfoCount = 1;
-    deviceCreateInfo.pQueueCreateInfos = &deviceQueueCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = deviceQueueCreateInfos.size();
+    deviceCreateInfo.pQueueCreateInfos = deviceQueueCreateInfos.data();
     deviceCreateInfo.enabledLayerCount = enabledDeviceLayerNames.size();
     deviceCreateInfo.ppEnabledLayerNames = enabledDeviceLayerNames.data();
     deviceCreateInfo.enabledExtensionCount = enabledDeviceExtensionNames.size();
     deviceCreateInfo.ppEnabledExtensionNames = enabledDeviceExtensionNames.data();
-    deviceCreateInfo.pEnabledFeatures = &physicalDeviceFeatures;
+    deviceCreateInfo.pEnabledFeatures = VK_NULL_HANDLE;
     // create device
     VkDevice device{};
-    vkCreateDevice(physicalDevices[0], &deviceCreateInfo, VK_NULL_HANDLE, &device);
+    vkCreateDevice(physicalDevice, &deviceCreateInfo, VK_NULL_HANDLE, &device);
     assert(device);
+    LoadVulkanDevice(device);
 
     // allocator create info
+    VmaVulkanFunctions vmaVulkanFunctions = GetVmaVulkanFunctions();
     VmaAllocatorCreateInfo allocatorCreateInfo{};
-    allocatorCreateInfo.flags = 0;
-    allocatorCreateInfo.physicalDevice = physicalDevices[0];
+    allocatorCreateInfo.flags = capabilities.bufferDeviceAddress ? VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT : 0;
+    allocatorCreateInfo.physicalDevice = physicalDevice;
     allocatorCreateInfo.device = device;
     allocatorCreateInfo.preferredLargeHeapBlockSize = 0;
     allocatorCreateInfo.pAllocationCallbacks = VK_NULL_HANDLE;
     allocatorCreateInfo.pDeviceMemoryCallbacks = VK_NULL_HANDLE;
     allocatorCreateInfo.pHeapSizeLimit = VK_NULL_HANDLE;
     allocatorCreateInfo.instance = instance;
-    allocatorCreateInfo.vulkanApiVersion = VK_API_VERSION_1_3;
+    allocatorCreateInfo.pVulkanFunctions = &vmaVulkanFunctions;
+    allocatorCreateInfo.vulkanApiVersion = capabilities.apiVersion;
     VmaAllocator allocator{};
     vmaCreateAllocator(&allocatorCreateInfo, &allocator);
     assert(allocator);
 
-    // get device queue
-    VkQueue queue{};
-    vkGetDeviceQueue(device, 0, 0, &queue);
-    assert(queue);
-
-    // create shader compiler
-    shaderc_compiler_t shadercCompiler{};
-    shadercCompiler = shaderc_compiler_initialize();
-    assert(shadercCompiler);
-
-    // compile shader
-    shaderc_compilation_result_t computeShaderData{};
-    computeShaderData = CompileComputeShader(shadercCompiler, computeShader_ImageWrite);
-    assert(computeShaderData);
-    // shader module create info
-    VkShaderModuleCreateInfo computeShaderModuleCreateInfo{};
-    computeShaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    computeShaderModuleCreateInfo.pNext = VK_NULL_HANDLE;
-    computeShaderModuleCreateInfo.flags = 0;
-    computeShaderModuleCreateInfo.codeSize = shaderc_result_get_length(computeShaderData);
-    computeShaderModuleCreateInfo.pCode = (uint32_t *)shaderc_result_get_bytes(computeShaderData);
-    // create shader module
-    VkShaderModule computeShaderModule{}; 
-    vkCreateShaderModule(device, &computeShaderModuleCreateInfo, VK_NULL_HANDLE, &computeShaderModule);
-    assert(computeShaderModule);
-    // pipeline shader stage create info
-    VkPipelineShaderStageCreateInfo computeShaderStageCreateInfo{};
-    computeShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    computeShaderStageCreateInfo.pNext = VK_NULL_HANDLE;
-    computeShaderStageCreateInfo.flags = 0;
-    computeShaderStageCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-    computeShaderStageCreateInfo.module = computeShaderModule;
-    computeShaderStageCreateInfo.pName = "main";
-    computeShaderStageCreateInfo.pSpecializationInfo = VK_NULL_HANDLE;
-
-    // descriptor set layout binding
-    VkDescriptorSetLayoutBinding inputImage  { 0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  1, VK_SHADER_STAGE_ALL, VK_NULL_HANDLE };
-    VkDescriptorSetLayoutBinding outputImage { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  1, VK_SHADER_STAGE_ALL, VK_NULL_HANDLE };
-    VkDescriptorSetLayoutBinding solidColor  { 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_ALL, VK_NULL_HANDLE };
-    // descriptor set layout create info
-    VkDescriptorSetLayoutBinding descSetLayoutBindings[] = { inputImage, outputImage, solidColor };
-    VkDescriptorSetLayoutCreateInfo descSetLayoutCreateInfo{};
-    descSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    descSetLayoutCreateInfo.pNext = VK_NULL_HANDLE;
-    descSetLayoutCreateInfo.flags = 0;
-    descSetLayoutCreateInfo.bindingCount = 3;
-    descSetLayoutCreateInfo.pBindings = descSetLayoutBindings;
-    // create descriptor set layout
-    VkDescriptorSetLayout descSetLayout{};
-    vkCreateDescriptorSetLayout(device, &descSetLayoutCreateInfo, VK_NULL_HANDLE, &descSetLayout);
-    assert(descSetLayout);
-    // pipeline layout create info
-    VkDescriptorSetLayout descSetLayouts[] { descSetLayout };
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
-    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutCreateInfo.pNext = VK_NULL_HANDLE;
-    pipelineLayoutCreateInfo.flags = 0;
-    pipelineLayoutCreateInfo.setLayoutCount = 1;
-    pipelineLayoutCreateInfo.pSetLayouts = descSetLayouts;
-    pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-    pipelineLayoutCreateInfo.pPushConstantRanges = VK_NULL_HANDLE;
-    // create pypeline layout
-    VkPipelineLayout pipelineLayout{};
-    vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, VK_NULL_HANDLE, &pipelineLayout);
-    assert(pipelineLayout);
-
-    // compute pipeline create info
-    VkComputePipelineCreateInfo pipelineCreateInfo{};
-    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-    pipelineCreateInfo.pNext = VK_NULL_HANDLE;
-    pipelineCreateInfo.flags = 0;
-    pipelineCreateInfo.stage = computeShaderStageCreateInfo;
-    pipelineCreateInfo.layout = pipelineLayout;
-    pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
-    pipelineCreateInfo.basePipelineIndex = 0;
-    // create compute pipeline
-    VkPipeline computePipeline;
-    vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, VK_NULL_HANDLE, &computePipeline);
-    assert(computePipeline);
-
-    // buffer create info
+    // get device queues
+    DeviceQueues queues = GetDeviceQueues(device, queueFamilies);
+
+    // dispatch and submit overhead of current runtime profile
+    if (HasOption(argc, argv, "--bench-overhead")) {
+        OverheadReport overheadReport = MeasureDispatchSubmitOverhead(device, queues.compute, queueFamilies.compute, 100000, 1000);
+        PrintOverheadReport(GetRuntimeProfileName(profileSettings.profile), overheadReport);
+    }
+
+    // command recording cost through loader trampolines and through device dispatch table
+    if (HasOption(argc, argv, "--bench-dispatch-table"))
+        PrintRecordingCostReport(MeasureRecordingCost(instance, device, queueFamilies.compute, 100000));
+
+    // kernel compile context (kernels not embedded at build time are compiled at runtime)
+    KernelCompileContext kernelCompileContext{};
+#ifndef VKC_NO_SHADERC
+    // shader compiler (initialized on first cache miss) and SPIR-V cache
+    // --kernel-dir=<dir> (VKC_KERNEL_DIR), default "shaders"
+    // --shader-cache=<dir> (VKC_SHADER_CACHE), --shader-cache-size=<MB> (VKC_SHADER_CACHE_SIZE), --shader-cache=off disables cache
+    std::unique_ptr<ShaderCompiler> shaderCompiler = std::make_unique<ShaderCompiler>();
+    std::unique_ptr<SpirvCache> spirvCache{};
+    std::string kernelDirectory = GetOption(argc, argv, "--kernel-dir", "VKC_KERNEL_DIR");
+    std::string spirvCacheDirectory = GetOption(argc, argv, "--shader-cache", "VKC_SHADER_CACHE");
+    const uint64_t spirvCacheSize = GetUintOption(argc, argv, "--shader-cache-size", "VKC_SHADER_CACHE_SIZE", 64, 0, 1u << 20);
+    if (spirvCacheDirectory != "off")
+        spirvCache = std::make_unique<SpirvCache>(spirvCacheDirectory.empty() ? ".cache/spirv" : spirvCacheDirectory, spirvCacheSize << 20);
+    // kernel library: --kernel-include-dir=<dir> (VKC_KERNEL_INCLUDE_DIR), default "<kernel-dir>/include", then embedded headers
+    kernelCompileContext.directory = kernelDirectory.empty() ? "shaders" : kernelDirectory;
+    std::string kernelIncludeDirectory = GetOption(argc, argv, "--kernel-include-dir", "VKC_KERNEL_INCLUDE_DIR");
+    ShaderIncludeResolver shaderIncludeResolver({ kernelIncludeDirectory.empty() ? kernelCompileContext.directory / "include" : std::filesystem::path(kernelIncludeDirectory) });
+    // compile options: target environment of negotiated api version
+    // --shader-opt=<zero|size|performance> (VKC_SHADER_OPT), default performance, --shader-debug-info keeps debug info
+    ShaderCompileOptions shaderCompileOptions{};
+    shaderCompileOptions.SetTargetApiVersion(capabilities.apiVersion);
+    shaderCompileOptions.optimizationLevel = ParseOptimizationLevel(GetOption(argc, argv, "--shader-opt", "VKC_SHADER_OPT"));
+    shaderCompileOptions.generateDebugInfo = HasOption(argc, argv, "--shader-debug-info");
+    shaderCompileOptions.includeResolver = &shaderIncludeResolver;
+    kernelCompileContext.cache = spirvCache.get();
+    kernelCompileContext.compiler = shaderCompiler.get();
+    kernelCompileContext.options = &shaderCompileOptions;
+#endif
+
+    // executor frames in flight: parameter ring regions, descriptor pools, descriptor buffer regions and bindless slots are reused per frame slot
+    const uint32_t framesInFlight = 2;
+
+    // descriptor set and pipeline layouts from SPIR-V reflection, shared by kernels with identical layouts
+    // kernel resources are push descriptors when VK_KHR_push_descriptor is present (no descriptor set allocation),
+    // otherwise descriptor buffer sets when VK_EXT_descriptor_buffer is present (no pools), otherwise pool allocated sets
+    // --descriptors=<push|buffer|sets|bindless> (VKC_DESCRIPTORS) forces binding mode, bindless processes a batch of images
+    // (--batch=<count> or VKC_BATCH, default 256) with one dispatch indexing them from a batch table
+    std::string descriptorMode = GetOption(argc, argv, "--descriptors", "VKC_DESCRIPTORS");
+    std::unique_ptr<BindlessDescriptors> bindlessDescriptors{};
+    if (descriptorMode == "bindless") {
+        if (SupportsBindlessDescriptors(capabilities)) bindlessDescriptors = std::make_unique<BindlessDescriptors>(device, capabilities, framesInFlight);
+        else std::cout << "Bindless descriptors: descriptor indexing not supported, default descriptor binding is used" << std::endl;
+    }
+    const bool bindless = bindlessDescriptors && *bindlessDescriptors;
+    const bool autoDescriptors = descriptorMode.empty() || (descriptorMode == "bindless" && !bindless);
+    const bool descriptorBuffers = capabilities.descriptorBuffer && (descriptorMode == "buffer" || (autoDescriptors && !capabilities.pushDescriptor));
+    const bool pushDescriptors = capabilities.pushDescriptor && (descriptorMode == "push" || autoDescriptors);
+    std::unique_ptr<LayoutCache> layoutCache = std::make_unique<LayoutCache>(device, pushDescriptors ? capabilities.maxPushDescriptors : 0,
+        bindless ? bindlessDescriptors->GetSetLayout() : VK_NULL_HANDLE, descriptorBuffers);
+
+    // persistent pipeline cache: --pipeline-cache=<dir|off> (VKC_PIPELINE_CACHE), default ".cache/pipelines"
+    // saved every 30 seconds while pipelines are created and on shutdown
+    std::string pipelineCacheDirectory = GetOption(argc, argv, "--pipeline-cache", "VKC_PIPELINE_CACHE");
+    std::unique_ptr<PipelineCache> pipelineCache{};
+    if (pipelineCacheDirectory != "off") {
+        pipelineCache = std::make_unique<PipelineCache>(device, physicalDeviceInfo.properties, pipelineCacheDirectory.empty() ? ".cache/pipelines" : pipelineCacheDirectory, capabilities.pipelineCreationFeedback);
+        pipelineCache->StartPeriodicSave(std::chrono::seconds(30));
+    }
+
+    // shader object binaries: --shader-objects=<dir|off> (VKC_SHADER_OBJECTS), default ".cache/shaders"
+    // warm runs create kernels from stored driver binaries instead of compiling pipelines (VK_EXT_shader_object only)
+    std::string shaderBinaryDirectory = GetOption(argc, argv, "--shader-objects", "VKC_SHADER_OBJECTS");
+    std::unique_ptr<ShaderBinaryCache> shaderBinaries{};
+    if (capabilities.shaderObject && shaderBinaryDirectory != "off")
+        shaderBinaries = std::make_unique<ShaderBinaryCache>(device, physicalDeviceInfo.properties, capabilities, shaderBinaryDirectory.empty() ? ".cache/shaders" : shaderBinaryDirectory);
+
+    // build kernels on worker pool (--build-threads=<count> or VKC_BUILD_THREADS, default hardware concurrency)
+    // (invalid counts fall back to hardware concurrency, zero means hardware concurrency as well)
+    const uint32_t buildThreads = (uint32_t)GetUintOption(argc, argv, "--build-threads", "VKC_BUILD_THREADS", std::max(1u, std::thread::hardware_concurrency()), 0, 1024);
+    std::unique_ptr<ThreadPool> threadPool = std::make_unique<ThreadPool>(buildThreads);
+    // pipelines are created on worker pool in background, dispatch waits only for the pipeline it binds
+    std::unique_ptr<PipelineRegistry> pipelineRegistry = std::make_unique<PipelineRegistry>(device, *threadPool, pipelineCache.get(), shaderBinaries.get());
+    // kernel parameters: push constants when they fit device limit, otherwise spilled to parameter ring (params_ubo variant)
+    // --kernel-params=<push|ubo> (VKC_KERNEL_PARAMS) forces parameter path
+    std::string kernelParams = GetOption(argc, argv, "--kernel-params", "VKC_KERNEL_PARAMS");
+    // (bindless variant and descriptor buffer layouts take parameters in push constants only)
+    const bool spillKernelParams = !bindless && !descriptorBuffers && (kernelParams == "ubo" || (kernelParams != "push" && !FitsPushConstants<ImageWriteParams>(physicalDeviceInfo.properties.limits)));
+    std::vector<KernelBuildRequest> kernelBuildRequests{
+        { "image_write", bindless ? "bindless" : spillKernelParams ? "params_ubo" : "default" }
+    };
+    Stopwatch kernelBuildStopwatch{};
+    std::vector<KernelBuild> kernelBuilds = BuildKernels(*threadPool, *pipelineRegistry, &kernelCompileContext, *layoutCache, kernelBuildRequests);
+    PrintKernelBuildTimings(kernelBuildRequests, kernelBuilds, kernelBuildStopwatch.ElapsedMs());
+#ifndef VKC_NO_SHADERC
+    if (spirvCache) std::cout << "SPIR-V cache: " << spirvCache->GetHitCount() << " hits, " << spirvCache->GetMissCount() << " misses (" << spirvCache->GetStaleCount() << " stale)" << std::endl;
+#endif
+    for (size_t i = 0; i < kernelBuilds.size(); i++)
+        PrintSpirvReflection((kernelBuildRequests[i].kernel + "." + kernelBuildRequests[i].variant).c_str(), kernelBuilds[i].reflection);
+
+    // buffer-only kernels (--buffer-fill): buffers are passed as device addresses in push constants, no descriptor sets
+    const bool bufferFill = HasOption(argc, argv, "--buffer-fill") && capabilities.bufferDeviceAddress;
+    std::vector<KernelBuildRequest> bufferKernelBuildRequests{};
+    std::vector<KernelBuild> bufferKernelBuilds{};
+    if (bufferFill) {
+        bufferKernelBuildRequests.push_back({ "buffer_fill", "default" });
+        bufferKernelBuilds = BuildKernels(*threadPool, *pipelineRegistry, &kernelCompileContext, *layoutCache, bufferKernelBuildRequests);
+        PrintSpirvReflection("buffer_fill.default", bufferKernelBuilds[0].reflection);
+        const bool argsMatch = CheckKernelArgs<BufferFillArgs>("buffer_fill", bufferKernelBuilds[0].reflection, bufferFillArgMembers);
+        assert(argsMatch);
+        assert(bufferKernelBuilds[0].pipeline.IsValid());
+    }
+    std::cout << "Layout cache: " << layoutCache->GetDescriptorSetLayoutCount() << " descriptor set layouts, " << layoutCache->GetPipelineLayoutCount() << " pipeline layouts" << std::endl;
+
+    // gpu timestamps of compute queue
+    const uint32_t timestampValidBits = physicalDeviceInfo.queueFamilies[queueFamilies.compute].timestampValidBits;
+    const float timestampPeriod = timestampValidBits ? physicalDeviceInfo.properties.limits.timestampPeriod : 0.0f;
+
+    // problem size (output image), dispatch covers it with workgroups of specialized local size
+    // bindless: batch of small images, one workgroup layer per batch item
+    // (one workgroup layer and two bindless storage images per batch item, image array is clamped to update after bind limit)
+    const uint32_t maxBatchCount = bindless ?
+        std::max(1u, std::min(physicalDeviceInfo.properties.limits.maxComputeWorkGroupCount[2], bindlessDescriptors->GetStorageImageCapacity() / 2)) : 1;
+    const uint32_t batchCount = bindless ? (uint32_t)GetUintOption(argc, argv, "--batch", "VKC_BATCH", std::min(256u, maxBatchCount), 1, maxBatchCount) : 1;
+    const uint32_t problemSize[3]{ bindless ? 64u : 512u, bindless ? 64u : 512u, batchCount };
+    auto recordProblemDispatch = [&](VkCommandBuffer commandBuffer, const KernelProgram& program, const uint32_t localSize[3]) {
+        BindKernelProgram(commandBuffer, program);
+        vkCmdDispatch(commandBuffer, (problemSize[0] + localSize[0] - 1) / localSize[0], (problemSize[1] + localSize[1] - 1) / localSize[1], (problemSize[2] + localSize[2] - 1) / localSize[2]);
+    };
+
+    // per thread, per frame descriptor pools sized from kernel layout statistics
+    std::unique_ptr<DescriptorAllocator> descriptorAllocator = std::make_unique<DescriptorAllocator>(device, framesInFlight);
+    for (const auto& kernelBuild : kernelBuilds)
+        descriptorAllocator->AddKernelStatistics(kernelBuild.reflection, kernelBuild.layout.pushDescriptorSet);
+
+    // parameter ring buffer (spilled kernel parameters only): one region per executor frame in flight
     VkBufferCreateInfo bufferCreateInfo{};
     bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferCreateInfo.pNext = VK_NULL_HANDLE;
     bufferCreateInfo.flags = 0;
-    bufferCreateInfo.size = 512;
-    bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-    bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    bufferCreateInfo.queueFamilyIndexCount = 1;
-    bufferCreateInfo.pQueueFamilyIndices = &queueFamilyIndex;
-    // allocation create info
+    bufferCreateInfo.size = framesInFlight * 64 * 1024;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferCreateInfo.sharingMode = queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    bufferCreateInfo.queueFamilyIndexCount = queueFamilyIndices.size();
+    bufferCreateInfo.pQueueFamilyIndices = queueFamilyIndices.data();
+    // allocation create info: persistently mapped and coherent, parameters are written while recording
     VmaAllocationCreateInfo allocationCreateInfo{};
-    allocationCreateInfo.flags = 0;
+    allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
     allocationCreateInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
-    allocationCreateInfo.requiredFlags = 0;
+    allocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
     allocationCreateInfo.preferredFlags = 0;
     allocationCreateInfo.memoryTypeBits = 0;
     allocationCreateInfo.pool = VK_NULL_HANDLE;
     allocationCreateInfo.pUserData = VK_NULL_HANDLE;
     allocationCreateInfo.priority = 0.0f;
-    // create and allocate buffer
+    // create and allocate buffer, parameter ring over its mapping
     VkBuffer buffer{};
     VmaAllocation bufferAllocation{};
-    vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &buffer, &bufferAllocation, VK_NULL_HANDLE);
-    assert(buffer);
-    assert(bufferAllocation);
+    std::unique_ptr<ParameterRing> parameterRing{};
+    if (spillKernelParams) {
+        VmaAllocationInfo bufferAllocationInfo{};
+        vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &buffer, &bufferAllocation, &bufferAllocationInfo);
+        assert(buffer);
+        assert(bufferAllocation);
+        parameterRing = std::make_unique<ParameterRing>(device, *layoutCache, physicalDeviceInfo.properties.limits, buffer, bufferAllocationInfo.pMappedData,
+            bufferCreateInfo.size, (uint32_t)sizeof(ImageWriteParams), framesInFlight);
+        assert(parameterRing->GetDescriptorSet());
+    }
+
+    // descriptor buffer ring (descriptor buffer sets, or descriptor backend benchmark): one region per executor frame in flight
+    const bool benchDescriptorBackend = HasOption(argc, argv, "--bench-descriptor-backend") && capabilities.descriptorBuffer;
+    VkBuffer descriptorBuffer{};
+    VmaAllocation descriptorBufferAllocation{};
+    std::unique_ptr<DescriptorBufferRing> descriptorBufferRing{};
+    if (descriptorBuffers || benchDescriptorBackend) {
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+        VmaAllocationInfo descriptorBufferAllocationInfo{};
+        vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &descriptorBuffer, &descriptorBufferAllocation, &descriptorBufferAllocationInfo);
+        assert(descriptorBuffer);
+        assert(descriptorBufferAllocation);
+        descriptorBufferRing = std::make_unique<DescriptorBufferRing>(device, capabilities, descriptorBuffer, descriptorBufferAllocationInfo.pMappedData,
+            bufferCreateInfo.size, framesInFlight);
+    }
+
+    // staging ring of uploads: --staging-size=<MB> (VKC_STAGING_SIZE), default 16
+    // persistently mapped, sequential write access (write combined memory is fine, host never reads it)
+    bufferCreateInfo.size = GetUintOption(argc, argv, "--staging-size", "VKC_STAGING_SIZE", 16, 1, 1u << 20) << 20;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+    allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    VkBuffer stagingBuffer{};
+    VmaAllocation stagingBufferAllocation{};
+    VmaAllocationInfo stagingBufferAllocationInfo{};
+    vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &stagingBuffer, &stagingBufferAllocation, &stagingBufferAllocationInfo);
+    assert(stagingBuffer);
+    assert(stagingBufferAllocation);
+    std::unique_ptr<StagingRing> stagingRing = std::make_unique<StagingRing>(stagingBuffer, stagingBufferAllocationInfo.pMappedData, bufferCreateInfo.size,
+        std::max<VkDeviceSize>(16, physicalDeviceInfo.properties.limits.optimalBufferCopyOffsetAlignment));
+
+    // readback ring: --readback-size=<MB> (VKC_READBACK_SIZE), default 16
+    // host cached memory (random access), reads of write combined memory are an order of magnitude slower,
+    // non coherent memory is invalidated per delivered range (size is a multiple of atom size)
+    const VkDeviceSize nonCoherentAtomSize = std::max<VkDeviceSize>(1, physicalDeviceInfo.properties.limits.nonCoherentAtomSize);
+    bufferCreateInfo.size = (GetUintOption(argc, argv, "--readback-size", "VKC_READBACK_SIZE", 16, 1, 1u << 20) << 20) / nonCoherentAtomSize * nonCoherentAtomSize;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+    allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+    allocationCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+    VkBuffer readbackBuffer{};
+    VmaAllocation readbackBufferAllocation{};
+    VmaAllocationInfo readbackBufferAllocationInfo{};
+    vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &readbackBuffer, &readbackBufferAllocation, &readbackBufferAllocationInfo);
+    assert(readbackBuffer);
+    assert(readbackBufferAllocation);
+    VkMemoryPropertyFlags readbackMemoryProperties{};
+    vmaGetAllocationMemoryProperties(allocator, readbackBufferAllocation, &readbackMemoryProperties);
+    std::unique_ptr<ReadbackQueue> readbackQueue = std::make_unique<ReadbackQueue>(readbackBuffer, readbackBufferAllocationInfo.pMappedData, bufferCreateInfo.size,
+        allocator, readbackBufferAllocation, (readbackMemoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0, nonCoherentAtomSize);
+    std::cout << "Readback ring: " << (readbackMemoryProperties & VK_MEMORY_PROPERTY_HOST_CACHED_BIT ? "host cached" : "uncached") << ", ";
+    std::cout << (readbackMemoryProperties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT ? "coherent" : "non coherent") << " memory" << std::endl;
+    allocationCreateInfo.preferredFlags = 0;
 
     // image create info
     VkImageCreateInfo imageCreateInfo{};
@@ -259,97 +437,448 @@ int main(int argc, char** argv) {
     imageCreateInfo.pNext = VK_NULL_HANDLE;
     imageCreateInfo.flags = 0;
     imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageCreateInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
-    imageCreateInfo.extent = { 512, 512, 1 };
+    imageCreateInfo.format = VK_FORMAT_R8G8B8A8_UINT; // rgba8ui storage images of image_write
+    imageCreateInfo.extent = { problemSize[0], problemSize[1], 1 };
     imageCreateInfo.mipLevels = 1;
     imageCreateInfo.arrayLayers = 1;
     imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
     imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageCreateInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageCreateInfo.queueFamilyIndexCount = 1;
-    imageCreateInfo.pQueueFamilyIndices = &queueFamilyIndex;
+    imageCreateInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    imageCreateInfo.sharingMode = queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    imageCreateInfo.queueFamilyIndexCount = queueFamilyIndices.size();
+    imageCreateInfo.pQueueFamilyIndices = queueFamilyIndices.data();
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    // create and allocate image
-    VkImage image{};
-    VmaAllocation imageAllocation{};
+    // create and allocate input and output images (pair per batch item)
+    std::vector<VkImage> images(2 * batchCount);
+    std::vector<VmaAllocation> imageAllocations(2 * batchCount);
+    std::vector<VkImageView> imageViews(2 * batchCount);
+    allocationCreateInfo.flags = 0;
     allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-    vmaCreateImage(allocator, &imageCreateInfo, &allocationCreateInfo, &image, &imageAllocation, VK_NULL_HANDLE);
-    assert(image);
-    assert(imageAllocation);
-
-    // command pool create info
-    VkCommandPoolCreateInfo commandPoolCreateInfo{};
-    commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    commandPoolCreateInfo.pNext = VK_NULL_HANDLE;
-    commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    commandPoolCreateInfo.queueFamilyIndex = 0;
-    // create command pool
-    VkCommandPool commandPool{};
-    vkCreateCommandPool(device, &commandPoolCreateInfo, VK_NULL_HANDLE, &commandPool);
-    assert(commandPool);
-    // command buffer allocate info
-    VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
-    commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    commandBufferAllocateInfo.pNext = VK_NULL_HANDLE;
-    commandBufferAllocateInfo.commandPool = commandPool;
-    commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    commandBufferAllocateInfo.commandBufferCount = 1;
-    // create command buffer
-    VkCommandBuffer commandBuffer{};
-    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
-    assert(commandBuffer);
-
-    // reset command pool and buffer
-    vkResetCommandPool(device, commandPool, 0);
-    vkResetCommandBuffer(commandBuffer, 0);
-    
-    // begin command buffer
-    VkCommandBufferBeginInfo commandBufferBeginInfo{};
-    commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    commandBufferBeginInfo.pNext = VK_NULL_HANDLE;
-    commandBufferBeginInfo.flags = 0;
-    commandBufferBeginInfo.pInheritanceInfo = VK_NULL_HANDLE;
-    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
-    //vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 0, 0, 0, 0);
-    //vkCmdDispatch(commandBuffer, 64, 64, 1);
-    vkEndCommandBuffer(commandBuffer);
-
-    // queue submit and wait
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.pNext = VK_NULL_HANDLE;
-    submitInfo.waitSemaphoreCount = 0;
-    submitInfo.pWaitSemaphores = VK_NULL_HANDLE;
-    submitInfo.pWaitDstStageMask = VK_NULL_HANDLE;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
-    submitInfo.signalSemaphoreCount = 0;
-    submitInfo.pSignalSemaphores = VK_NULL_HANDLE;
-    vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(queue);
-
-    // free command buffer and destroy command pool
-    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
-    vkDestroyCommandPool(device, commandPool, VK_NULL_HANDLE);
+    allocationCreateInfo.requiredFlags = 0;
+    for (size_t i = 0; i < images.size(); i++) {
+        vmaCreateImage(allocator, &imageCreateInfo, &allocationCreateInfo, &images[i], &imageAllocations[i], VK_NULL_HANDLE);
+        assert(images[i]);
+        assert(imageAllocations[i]);
+        // image view create info
+        VkImageViewCreateInfo imageViewCreateInfo{};
+        imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        imageViewCreateInfo.pNext = VK_NULL_HANDLE;
+        imageViewCreateInfo.flags = 0;
+        imageViewCreateInfo.image = images[i];
+        imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        imageViewCreateInfo.format = imageCreateInfo.format;
+        imageViewCreateInfo.components = { VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY };
+        imageViewCreateInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+        vkCreateImageView(device, &imageViewCreateInfo, VK_NULL_HANDLE, &imageViews[i]);
+        assert(imageViews[i]);
+    }
+
+    // input image texels (rgba8 gradient), uploaded through staging ring into every input image
+    std::vector<uint32_t> inputTexels(problemSize[0] * problemSize[1]);
+    for (uint32_t y = 0; y < problemSize[1]; y++)
+        for (uint32_t x = 0; x < problemSize[0]; x++)
+            inputTexels[y * problemSize[0] + x] = (x * 255 / problemSize[0]) | ((y * 255 / problemSize[1]) << 8) | 0xff000000;
+
+    // bindless batch: image pairs in bindless storage image slots, batch table in bindless storage buffer slot
+    ImageWriteBatchParams imageWriteBatchParams{};
+    std::vector<ImageWriteBatchItem> batchItems{};
+    VkBuffer batchTableBuffer{};
+    VmaAllocation batchTableAllocation{};
+    if (bindless) {
+        batchItems.resize(batchCount);
+        for (uint32_t i = 0; i < batchCount; i++) {
+            batchItems[i] = { bindlessDescriptors->AddStorageImage(imageViews[2 * i]), bindlessDescriptors->AddStorageImage(imageViews[2 * i + 1]), problemSize[0], problemSize[1] };
+            assert(batchItems[i].inputImage != UINT32_MAX && batchItems[i].outputImage != UINT32_MAX);
+        }
+        // batch table: device local storage buffer, uploaded through staging ring
+        bufferCreateInfo.size = batchItems.size() * sizeof(ImageWriteBatchItem);
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        allocationCreateInfo.flags = 0;
+        allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        allocationCreateInfo.requiredFlags = 0;
+        vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &batchTableBuffer, &batchTableAllocation, VK_NULL_HANDLE);
+        assert(batchTableBuffer);
+        assert(batchTableAllocation);
+        imageWriteBatchParams.batchTable = bindlessDescriptors->AddStorageBuffer(batchTableBuffer);
+        imageWriteBatchParams.batchCount = batchCount;
+        assert(imageWriteBatchParams.batchTable != UINT32_MAX);
+    }
+
+    // buffer_fill pixels: device local storage buffer addressed through its device address
+    BufferFillArgs bufferFillArgs{};
+    VkBuffer pixelBuffer{};
+    VmaAllocation pixelBufferAllocation{};
+    if (bufferFill) {
+        bufferCreateInfo.size = problemSize[0] * problemSize[1] * sizeof(uint32_t);
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        allocationCreateInfo.flags = 0;
+        allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+        allocationCreateInfo.requiredFlags = 0;
+        vmaCreateBuffer(allocator, &bufferCreateInfo, &allocationCreateInfo, &pixelBuffer, &pixelBufferAllocation, VK_NULL_HANDLE);
+        assert(pixelBuffer);
+        assert(pixelBufferAllocation);
+        bufferFillArgs.pixels = GetDevicePointer<uint32_t>(device, pixelBuffer);
+        bufferFillArgs.pixelCount = problemSize[0] * problemSize[1];
+    }
+
+    // per dispatch parameters: push constants or parameter ring
+    const KernelParams imageWriteParams(kernelBuilds[0].reflection, kernelBuilds[0].layout, parameterRing.get());
+    std::cout << "Kernel " << kernelBuildRequests[0].kernel << ": parameters " << (bindless ? sizeof(ImageWriteBatchParams) : sizeof(ImageWriteParams)) << " bytes in ";
+    std::cout << (imageWriteParams.UsesPushConstants() ? "push constants" : imageWriteParams.UsesRing() ? "parameter ring" : "none") << std::endl;
+    // image_write reads its parameters in every variant, so they must land where the reflection placed them
+    const bool imageWriteParamsPlaced = spillKernelParams ? imageWriteParams.UsesRing() : imageWriteParams.UsesPushConstants();
+    if (!imageWriteParamsPlaced) std::cout << "Kernel " << kernelBuildRequests[0].kernel << ": parameters not found in reflection" << std::endl;
+    assert(imageWriteParamsPlaced);
+
+    // parameters of image_write dispatch (non-bindless variants)
+    const ImageWriteParams imageWriteDispatchParams{};
+
+    // descriptors of image_write set 0
+    const ImageWriteDescriptors imageWriteDescriptors{
+        { VK_NULL_HANDLE, imageViews[0], VK_IMAGE_LAYOUT_GENERAL },
+        { VK_NULL_HANDLE, imageViews[1], VK_IMAGE_LAYOUT_GENERAL }
+    };
+
+    // descriptor set data of image_write set 0 (descriptor buffer writes and benchmarks)
+    const std::vector<std::vector<VkDescriptorSetLayoutBinding>> imageWriteSetBindings = GetKernelSetBindings(kernelBuilds[0].reflection);
+    const std::vector<VkDescriptorSetLayoutBinding> imageWriteBindings = imageWriteSetBindings.empty() ? std::vector<VkDescriptorSetLayoutBinding>{} : imageWriteSetBindings[0];
+    DescriptorSetData imageWriteSetData(imageWriteBindings);
+    imageWriteSetData.SetImage(0, imageViews[0], VK_IMAGE_LAYOUT_GENERAL).SetImage(1, imageViews[1], VK_IMAGE_LAYOUT_GENERAL);
+
+    const bool pushImageWriteDescriptors = kernelBuilds[0].layout.pushDescriptorSet == 0;
+    if (bindless) std::cout << "Kernel " << kernelBuildRequests[0].kernel << ": bindless batch of " << batchCount << " images" << std::endl;
+    else std::cout << "Kernel " << kernelBuildRequests[0].kernel << ": set 0 " << (pushImageWriteDescriptors ? "push descriptors" : descriptorBuffers ? "descriptor buffer" : "allocated descriptor set") << std::endl;
+
+    // descriptor update cost per dispatch: VkWriteDescriptorSet arrays and update template
+    // (allocatable set layout of same bindings when kernel pushes set 0 or uses descriptor buffers)
+    if (HasOption(argc, argv, "--bench-descriptor-update") && !imageWriteBindings.empty()) {
+        VkDescriptorSet descriptorSet = descriptorAllocator->Allocate(layoutCache->GetDescriptorSetLayout(imageWriteBindings));
+        assert(descriptorSet);
+        PrintDescriptorUpdateReport(kernelBuildRequests[0].kernel.c_str(),
+            MeasureDescriptorUpdateCost(device, descriptorSet, layoutCache->GetDescriptorUpdateTemplate(imageWriteBindings), imageWriteSetData, 100000));
+    }
+
+    // descriptor backend cost per dispatch: pool allocated sets and descriptor buffer sets of same bindings
+    if (benchDescriptorBackend && !imageWriteBindings.empty()) {
+        PrintDescriptorBackendReport(kernelBuildRequests[0].kernel.c_str(),
+            MeasureDescriptorBackendCost(device, *descriptorAllocator, layoutCache->GetDescriptorSetLayout(imageWriteBindings), layoutCache->GetDescriptorUpdateTemplate(imageWriteBindings),
+                *descriptorBufferRing, layoutCache->GetDescriptorSetLayout(imageWriteBindings, VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT), imageWriteSetData, 800, 128));
+    }
+
+    // bind image_write set 0 (or bindless set) through layout of given build, false skips dispatch
+    // (shared by dispatch and tuning measurements, specialized pipelines of build share its layout)
+    auto bindImageWriteResources = [&](VkCommandBuffer commandBuffer, const KernelBuild& build) {
+        // storage images of set 0: input (binding 0) and output (binding 1), one update template call
+        // bindless: one set bind for whole batch, images are indexed by slots of batch table
+        bool imageWriteBound = true;
+        if (bindless) {
+            bindlessDescriptors->Bind(commandBuffer, build.layout.pipelineLayout);
+        } else if (build.layout.pushDescriptorSet == 0) {
+            imageWriteBound = PushDescriptorSet(commandBuffer, build.layout.updateTemplates[0], build.layout.updateTemplateDataSizes[0], build.layout.pipelineLayout, 0,
+                imageWriteDescriptors);
+        } else if (descriptorBuffers && !build.layout.setLayouts.empty()) {
+            // full frame region or descriptors the buffer can't hold: dispatch is skipped instead of reading stale descriptors
+            DescriptorBufferSet descriptorSet = descriptorBufferRing->Allocate(build.layout.setLayouts[0]);
+            imageWriteBound = descriptorSet && descriptorBufferRing->Write(descriptorSet, imageWriteSetData);
+            if (imageWriteBound) {
+                descriptorBufferRing->Bind(commandBuffer);
+                descriptorBufferRing->BindSet(commandBuffer, build.layout.pipelineLayout, 0, descriptorSet);
+            } else {
+                std::cout << "Descriptor buffer set not written, image_write dispatch skipped" << std::endl;
+            }
+        } else if (!build.layout.setLayouts.empty()) {
+            VkDescriptorSet descriptorSet = descriptorAllocator->Allocate(build.layout.setLayouts[0]);
+            assert(descriptorSet);
+            imageWriteBound = UpdateDescriptorSet(device, descriptorSet, build.layout.updateTemplates[0], build.layout.updateTemplateDataSizes[0], imageWriteDescriptors);
+            if (imageWriteBound) vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, build.layout.pipelineLayout, 0, 1, &descriptorSet, 0, VK_NULL_HANDLE);
+        }
+        if (!imageWriteBound && !descriptorBuffers) std::cout << "ImageWriteDescriptors smaller than set 0 update template, image_write dispatch skipped" << std::endl;
+        return imageWriteBound;
+    };
+    // record image_write parameters through layout of given build (push constants or parameter ring)
+    auto recordImageWriteParams = [&](VkCommandBuffer commandBuffer, const KernelBuild& build) {
+        const KernelParams params(build.reflection, build.layout, parameterRing.get());
+        return bindless ? params.Record(commandBuffer, imageWriteBatchParams) : params.Record(commandBuffer, imageWriteDispatchParams);
+    };
+
+    // upload -> dispatch -> readback on transfer and compute queues
+    // (jobs are tracked on timeline semaphore when supported, staging ranges are released against job values)
+    std::unique_ptr<AsyncComputeExecutor> executor = std::make_unique<AsyncComputeExecutor>(device, queues, framesInFlight, capabilities.timelineSemaphore);
+    // preparation job: input images and batch table uploaded, output images in general layout
+    // (tuning and optimization report below dispatch against the same resources as the dispatch job)
+    const uint64_t preparationValue = executor->Submit(
+        [&](VkCommandBuffer commandBuffer) {
+            // ranges of completed jobs are reusable
+            stagingRing->Reclaim(executor->GetCompletedValue());
+
+            // input images (even images) to transfer destination layout
+            std::vector<VkImageMemoryBarrier> imageBarriers(images.size() / 2);
+            for (size_t i = 0; i < imageBarriers.size(); i++) {
+                imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarriers[i].pNext = VK_NULL_HANDLE;
+                imageBarriers[i].srcAccessMask = 0;
+                imageBarriers[i].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                imageBarriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                imageBarriers[i].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                imageBarriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarriers[i].image = images[2 * i];
+                imageBarriers[i].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            }
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, (uint32_t)imageBarriers.size(), imageBarriers.data());
+
+            // texels and batch table through staging ring (dispatch waits upload semaphore)
+            for (size_t i = 0; i < imageBarriers.size(); i++) {
+                const StagingAllocation texels = stagingRing->Upload(inputTexels.data(), inputTexels.size() * sizeof(uint32_t));
+                if (!texels) {
+                    std::cout << "Staging ring full, input image " << i << " not uploaded" << std::endl;
+                    continue;
+                }
+                RecordStagingCopy(commandBuffer, texels, images[2 * i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, imageCreateInfo.extent);
+            }
+            if (bindless) {
+                const StagingAllocation batchTable = stagingRing->Upload(batchItems.data(), batchItems.size() * sizeof(ImageWriteBatchItem));
+                assert(batchTable);
+                RecordStagingCopy(commandBuffer, batchTable, batchTableBuffer);
+            }
+
+            // input images to general layout for storage access
+            for (auto& imageBarrier : imageBarriers) {
+                imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                imageBarrier.dstAccessMask = 0;
+                imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                imageBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            }
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, (uint32_t)imageBarriers.size(), imageBarriers.data());
+        },
+        [&](VkCommandBuffer commandBuffer) {
+            // output images (odd images) to general layout for storage access (contents are undefined before first dispatch)
+            std::vector<VkImageMemoryBarrier> imageBarriers(images.size() / 2);
+            for (size_t i = 0; i < imageBarriers.size(); i++) {
+                imageBarriers[i].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                imageBarriers[i].pNext = VK_NULL_HANDLE;
+                imageBarriers[i].srcAccessMask = 0;
+                imageBarriers[i].dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                imageBarriers[i].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+                imageBarriers[i].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+                imageBarriers[i].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarriers[i].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+                imageBarriers[i].image = images[2 * i + 1];
+                imageBarriers[i].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+            }
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, (uint32_t)imageBarriers.size(), imageBarriers.data());
+        },
+        {});
+    stagingRing->Release(preparationValue);
+    executor->Wait(preparationValue);
+
+    // per device tuning database: --tuning-db=<dir|off> (VKC_TUNING_DB), default ".cache/tuning"
+    // --autotune benchmarks workgroup sizes of every kernel for problem size bucket and stores the fastest
+    std::string tuningDirectory = GetOption(argc, argv, "--tuning-db", "VKC_TUNING_DB");
+    std::unique_ptr<TuningDatabase> tuningDatabase{};
+    if (tuningDirectory != "off")
+        tuningDatabase = std::make_unique<TuningDatabase>(tuningDirectory.empty() ? ".cache/tuning" : tuningDirectory, GetTuningDeviceKey(physicalDeviceInfo.properties));
+    const std::string problemSizeBucket = GetProblemSizeBucket(problemSize);
+    const bool autotune = HasOption(argc, argv, "--autotune");
+    for (size_t i = 0; i < kernelBuilds.size(); i++) {
+        if (!kernelBuilds[i].specializations) continue;
+        const std::string kernelName = kernelBuildRequests[i].kernel + "." + kernelBuildRequests[i].variant;
+        // candidates bind resources and parameters like the dispatch below (image_write only, other kernels with resources are not tuned)
+        const bool kernelResources = !kernelBuilds[i].reflection.bindings.empty() || kernelBuilds[i].reflection.pushConstantSize != 0;
+        if (autotune && i != 0 && kernelResources) {
+            std::cout << "Autotune " << kernelName << ": kernel resources not bound, skipped" << std::endl;
+        } else if (autotune) {
+            const TuningBind bind = i == 0 ? TuningBind([&](VkCommandBuffer commandBuffer) {
+                return bindImageWriteResources(commandBuffer, kernelBuilds[0]) && recordImageWriteParams(commandBuffer, kernelBuilds[0]);
+            }) : TuningBind{};
+            TuningResult tuningResult = AutotuneKernel(*kernelBuilds[i].specializations, device, queues.compute, queueFamilies.compute, timestampPeriod,
+                physicalDeviceInfo.properties.limits, capabilities.subgroupSize, bind, recordProblemDispatch);
+            if (timestampPeriod <= 0.0f) std::cout << "Autotune " << kernelName << ": gpu timestamps not supported" << std::endl;
+            else if (tuningResult.gpuMs < 0.0) std::cout << "Autotune " << kernelName << ": no candidate measured" << std::endl;
+            else if (tuningDatabase) tuningDatabase->Store(kernelName, problemSizeBucket, tuningResult);
+        }
+        const TuningResult* tuningResult = tuningDatabase ? tuningDatabase->Find(kernelName, problemSizeBucket) : nullptr;
+        if (!tuningResult) continue;
+        kernelBuilds[i].pipeline = kernelBuilds[i].specializations->RequestPipeline(tuningResult->constants, PipelinePriority::Dispatch);
+        kernelBuilds[i].specConstants = tuningResult->constants;
+        uint32_t tunedLocalSize[3]{};
+        GetSpecializedLocalSize(kernelBuilds[i].reflection, tuningResult->constants, tunedLocalSize);
+        std::cout << "Tuned " << kernelName << " [" << problemSizeBucket << "]: local size " << tunedLocalSize[0] << "x" << tunedLocalSize[1] << "x" << tunedLocalSize[2];
+        std::cout << ", gpu " << tuningResult->gpuMs << " ms" << std::endl;
+    }
+    if (autotune && tuningDatabase) tuningDatabase->Save();
+
+    // workgroup size override: --local-size=<x>x<y> (VKC_LOCAL_SIZE), specialized pipeline is requested with dispatch priority
+    std::string localSize = GetOption(argc, argv, "--local-size", "VKC_LOCAL_SIZE");
+    // (each dimension non-zero and within maxComputeWorkGroupSize, product within maxComputeWorkGroupInvocations, invalid sizes are ignored)
+    const VkPhysicalDeviceLimits& limits = physicalDeviceInfo.properties.limits;
+    const size_t localSizeSeparator = localSize.find('x');
+    uint64_t localSizeX{}, localSizeY = 1;
+    const bool localSizeValid = ParseUint(std::string_view(localSize).substr(0, localSizeSeparator), localSizeX) &&
+        (localSizeSeparator == std::string::npos || ParseUint(std::string_view(localSize).substr(localSizeSeparator + 1), localSizeY)) &&
+        localSizeX > 0 && localSizeY > 0 && localSizeX <= limits.maxComputeWorkGroupSize[0] && localSizeY <= limits.maxComputeWorkGroupSize[1] &&
+        localSizeX * localSizeY <= limits.maxComputeWorkGroupInvocations;
+    if (!localSize.empty() && !localSizeValid) {
+        std::cout << "Invalid --local-size \"" << localSize << "\", expected <x>x<y> within " << limits.maxComputeWorkGroupSize[0] << "x" << limits.maxComputeWorkGroupSize[1];
+        std::cout << " and " << limits.maxComputeWorkGroupInvocations << " invocations, ignored" << std::endl;
+    }
+    if (localSizeValid && kernelBuilds[0].specializations) {
+        kernelBuilds[0].specConstants = SpecConstants().SetLocalSize(kernelBuilds[0].reflection, (uint32_t)localSizeX, (uint32_t)localSizeY);
+        kernelBuilds[0].pipeline = kernelBuilds[0].specializations->RequestPipeline(kernelBuilds[0].specConstants, PipelinePriority::Dispatch);
+        std::cout << "Kernel " << kernelBuildRequests[0].kernel << ": local size " << localSizeX << "x" << localSizeY << std::endl;
+    }
+    assert(kernelBuilds[0].pipeline.IsValid());
+#ifndef VKC_NO_SHADERC
+    // SPIR-V size and kernel gpu time per optimization level
+    // (image_write binds resources and parameters like the dispatch job, other kernels with resources are not measured)
+    if (HasOption(argc, argv, "--report-optimization")) {
+        ReportKernelOptimizationLevels(*threadPool, device, queues.compute, queueFamilies.compute, timestampPeriod, kernelCompileContext, *layoutCache, kernelBuildRequests,
+            [&](VkCommandBuffer commandBuffer, size_t i, const KernelBuild& build) {
+                if (i == 0) return bindImageWriteResources(commandBuffer, build) && recordImageWriteParams(commandBuffer, build);
+                return build.reflection.bindings.empty() && build.reflection.pushConstantSize == 0;
+            },
+            [&](VkCommandBuffer commandBuffer, size_t i, const KernelProgram& program) {
+                uint32_t localSize[3]{};
+                GetSpecializedLocalSize(kernelBuilds[i].reflection, kernelBuildRequests[i].specConstants, localSize);
+                recordProblemDispatch(commandBuffer, program, localSize);
+            });
+    }
+#endif
+
+    // wait for dispatched pipeline only (resource creation above overlaps pipeline creation)
+    KernelProgram computeProgram = pipelineRegistry->Get(kernelBuilds[0].pipeline);
+    assert(computeProgram);
+    if (pipelineCache) pipelineCache->PrintReport();
+    if (shaderBinaries) shaderBinaries->PrintReport();
+
+    KernelProgram bufferFillProgram = bufferFill ? pipelineRegistry->Get(bufferKernelBuilds[0].pipeline) : KernelProgram{};
+    assert(!bufferFill || bufferFillProgram);
+
+    // workgroup size of dispatched pipeline
+    uint32_t dispatchLocalSize[3]{};
+    GetSpecializedLocalSize(kernelBuilds[0].reflection, kernelBuilds[0].specConstants, dispatchLocalSize);
+    uint32_t bufferFillLocalSize[3]{};
+    if (bufferFill) GetSpecializedLocalSize(bufferKernelBuilds[0].reflection, bufferKernelBuilds[0].specConstants, bufferFillLocalSize);
+
+    // dispatch job: image_write (and buffer_fill) dispatch, output readback
+    const uint64_t jobValue = executor->Submit(
+        {},
+        [&](VkCommandBuffer commandBuffer) {
+            // executor waited fence of frame slot, its descriptor pools can be reset
+            descriptorAllocator->BeginFrame();
+
+            // storage images of set 0 (or bindless set)
+            if (bindless) bindlessDescriptors->BeginFrame();
+            const bool imageWriteBound = bindImageWriteResources(commandBuffer, kernelBuilds[0]);
+
+            // output images are in general layout since preparation job, tuning dispatches may have written them
+            VkMemoryBarrier memoryBarrier{};
+            memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            memoryBarrier.pNext = VK_NULL_HANDLE;
+            memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+
+            if (imageWriteBound) {
+                const bool paramsRecorded = recordImageWriteParams(commandBuffer, kernelBuilds[0]);
+                if (!paramsRecorded) std::cout << "Kernel parameters not recorded, image_write dispatch skipped" << std::endl;
+                assert(paramsRecorded);
+                if (paramsRecorded) recordProblemDispatch(commandBuffer, computeProgram, dispatchLocalSize);
+            }
+
+            // buffer_fill: pointer in push constants, nothing to bind but the program
+            if (bufferFill) {
+                BindKernelProgram(commandBuffer, bufferFillProgram);
+                const bool argsRecorded = KernelParams(bufferKernelBuilds[0].reflection, bufferKernelBuilds[0].layout, nullptr).Record(commandBuffer, bufferFillArgs);
+                if (!argsRecorded) std::cout << "Kernel arguments not recorded, buffer_fill dispatch skipped" << std::endl;
+                assert(argsRecorded);
+                if (argsRecorded) vkCmdDispatch(commandBuffer, (bufferFillArgs.pixelCount + bufferFillLocalSize[0] - 1) / bufferFillLocalSize[0], 1, 1);
+            }
+        },
+        [&](VkCommandBuffer commandBuffer) {
+            // output image (first batch item) and buffer_fill pixels, delivered when job value completed
+            const bool imageRead = readbackQueue->ReadImage(commandBuffer, images[1], VK_IMAGE_LAYOUT_GENERAL, imageCreateInfo.extent, sizeof(uint32_t),
+                [&](const void* data, VkDeviceSize size) {
+                    // expected texel: input texel modulated by solid color (components within one step of rounding)
+                    const float* solidColor = bindless ? imageWriteBatchParams.solidColor : imageWriteDispatchParams.solidColor;
+                    const uint32_t* texels = (const uint32_t*)data;
+                    const size_t texelCount = std::min<size_t>(size / sizeof(uint32_t), inputTexels.size());
+                    size_t mismatchCount = 0;
+                    for (size_t i = 0; i < texelCount; i++) {
+                        for (uint32_t c = 0; c < 4; c++) {
+                            const float value = std::clamp((float)((inputTexels[i] >> (8 * c)) & 0xff) / 255.0f * solidColor[c], 0.0f, 1.0f);
+                            const int expected = (int)(value * 255.0f + 0.5f);
+                            if (std::abs((int)((texels[i] >> (8 * c)) & 0xff) - expected) > 1) {
+                                mismatchCount++;
+                                break;
+                            }
+                        }
+                    }
+                    std::cout << "Readback output image: " << texelCount - mismatchCount << "/" << texelCount << " texels match input modulated by solid color" << std::endl;
+                });
+            if (!imageRead) std::cout << "Readback ring full, output image not read" << std::endl;
+            if (bufferFill) {
+                readbackQueue->ReadBuffer(commandBuffer, pixelBuffer, 0, bufferFillArgs.pixelCount * sizeof(uint32_t),
+                    [&](const void* data, VkDeviceSize size) {
+                        const uint32_t* pixels = (const uint32_t*)data;
+                        std::cout << "Readback buffer_fill: " << std::count(pixels, pixels + size / sizeof(uint32_t), bufferFillArgs.packedColor) << "/" << size / sizeof(uint32_t);
+                        std::cout << " pixels filled" << std::endl;
+                    });
+            }
+        });
+    stagingRing->Release(jobValue);
+    readbackQueue->Release(jobValue);
+    if (parameterRing) parameterRing->NextFrame(); // ring regions follow executor frames
+    if (descriptorBufferRing) descriptorBufferRing->NextFrame();
+    // results are delivered from completed job values, host only blocks here because it has nothing else to do
+    executor->Wait(jobValue);
+    readbackQueue->Poll(executor->GetCompletedValue());
+    executor->WaitIdle();
+    stagingRing->Reclaim(executor->GetCompletedValue());
+    std::cout << "Staging ring: " << stagingRing->GetAllocationCount() << " uploads, " << stagingRing->GetAllocatedBytes() << " bytes, ";
+    std::cout << stagingRing->GetUsedSize() << "/" << stagingRing->GetSize() << " bytes in use" << std::endl;
+    std::cout << "Descriptor allocator: " << descriptorAllocator->GetPoolCount() << " pools" << std::endl;
+    if (bindless) bindlessDescriptors->PrintReport();
+
+    // destroy executor
+    executor.reset();
 
     // destroy resource
-    vmaDestroyImage(allocator, image, imageAllocation);
-    vmaDestroyBuffer(allocator, buffer, bufferAllocation);
+    descriptorAllocator.reset();
+    for (size_t i = 0; i < images.size(); i++) {
+        vkDestroyImageView(device, imageViews[i], VK_NULL_HANDLE);
+        vmaDestroyImage(allocator, images[i], imageAllocations[i]);
+    }
+    if (batchTableBuffer) vmaDestroyBuffer(allocator, batchTableBuffer, batchTableAllocation);
+    if (pixelBuffer) vmaDestroyBuffer(allocator, pixelBuffer, pixelBufferAllocation);
+    parameterRing.reset();
+    if (buffer) vmaDestroyBuffer(allocator, buffer, bufferAllocation);
+    descriptorBufferRing.reset();
+    if (descriptorBuffer) vmaDestroyBuffer(allocator, descriptorBuffer, descriptorBufferAllocation);
+    stagingRing.reset();
+    vmaDestroyBuffer(allocator, stagingBuffer, stagingBufferAllocation);
+    readbackQueue.reset();
+    vmaDestroyBuffer(allocator, readbackBuffer, readbackBufferAllocation);
 
     // destroy handles
-    vkDestroyPipeline(device, computePipeline, VK_NULL_HANDLE);
-    vkDestroyPipelineLayout(device, pipelineLayout, VK_NULL_HANDLE);
-    vkDestroyDescriptorSetLayout(device, descSetLayout, VK_NULL_HANDLE);
-    vkDestroyShaderModule(device, computeShaderModule, VK_NULL_HANDLE);
-    shaderc_result_release(computeShaderData);
-    shaderc_compiler_release(shadercCompiler);
+    kernelBuilds.clear();
+    bufferKernelBuilds.clear();
+    pipelineRegistry.reset();
+    threadPool.reset();
+    if (shaderBinaries) shaderBinaries->Save();
+    shaderBinaries.reset();
+    if (pipelineCache) pipelineCache->Save();
+    pipelineCache.reset();
+    layoutCache.reset();
+    bindlessDescriptors.reset();
+#ifndef VKC_NO_SHADERC
+    spirvCache.reset();
+    shaderCompiler.reset();
+#endif
     vmaDestroyAllocator(allocator);
     vkDestroyDevice(device, VK_NULL_HANDLE);
-    auto fnDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
-    if (fnDestroyDebugUtilsMessengerEXT)
-        fnDestroyDebugUtilsMessengerEXT(instance, debugUtilsMessengerEXT, VK_NULL_HANDLE);
+    DestroyDebugMessenger(instance, debugUtilsMessengerEXT);
     vkDestroyInstance(instance, VK_NULL_HANDLE);
+    UnloadVulkanLibrary();
     return 0;
 }
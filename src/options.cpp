@@ -0,0 +1,52 @@
+#include "options.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <charconv>
+#include <iostream>
+#include <algorithm>
+
+// get option value from command line or environment
+std::string GetOption(int argc, char** argv, const char* name, const char* envName) {
+    const size_t nameLength = strlen(name);
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], name, nameLength) != 0) continue;
+        if (argv[i][nameLength] == '=') return argv[i] + nameLength + 1;
+        if (argv[i][nameLength] == '\0' && i + 1 < argc) return argv[i + 1];
+    }
+    if (envName != nullptr) {
+        const char* envValue = getenv(envName);
+        if (envValue != nullptr) return envValue;
+    }
+    return {};
+}
+
+// check command line flag
+bool HasOption(int argc, char** argv, const char* name) {
+    for (int i = 1; i < argc; i++)
+        if (strcmp(argv[i], name) == 0) return true;
+    return false;
+}
+
+// parse unsigned decimal integer
+bool ParseUint(std::string_view text, uint64_t& value) {
+    const char* end = text.data() + text.size();
+    auto [ptr, errorCode] = std::from_chars(text.data(), end, value);
+    return !text.empty() && errorCode == std::errc{} && ptr == end;
+}
+
+// get unsigned integer option
+uint64_t GetUintOption(int argc, char** argv, const char* name, const char* envName, uint64_t defaultValue, uint64_t minValue, uint64_t maxValue) {
+    const std::string text = GetOption(argc, argv, name, envName);
+    if (text.empty()) return defaultValue;
+    uint64_t value{};
+    if (!ParseUint(text, value)) {
+        std::cout << "Invalid " << name << " value \"" << text << "\", expected unsigned integer, using " << defaultValue << std::endl;
+        return defaultValue;
+    }
+    if (value < minValue || value > maxValue) {
+        const uint64_t clampedValue = std::clamp(value, minValue, maxValue);
+        std::cout << name << " " << value << " is out of range [" << minValue << ", " << maxValue << "], using " << clampedValue << std::endl;
+        return clampedValue;
+    }
+    return value;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// get option value from command line ("--name=value" or "--name value") or from environment variable
+// command line has priority over environment, returns empty string if option is not set
+std::string GetOption(int argc, char** argv, const char* name, const char* envName = nullptr);
+
+// check command line flag ("--name")
+bool HasOption(int argc, char** argv, const char* name);
+
+// parse unsigned decimal integer (whole text, no sign or spaces), returns false for empty, invalid or out of range text
+bool ParseUint(std::string_view text, uint64_t& value);
+
+// get unsigned integer option, returns defaultValue when option is not set or invalid, values out of [minValue, maxValue] are clamped
+// (invalid and clamped values are reported)
+uint64_t GetUintOption(int argc, char** argv, const char* name, const char* envName, uint64_t defaultValue, uint64_t minValue = 0, uint64_t maxValue = UINT64_MAX);
@@ -0,0 +1,169 @@
+#include "pipeline_cache.hpp"
+#include "hash.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// pipeline cache file header, followed by vulkan pipeline cache data
+struct PipelineCacheFileHeader {
+    uint32_t magic = 0x4350564b; // "KVPC"
+    uint32_t version = 1;
+    uint64_t dataSize{};
+    uint64_t dataHash{};
+};
+
+// check vulkan pipeline cache data header matches device
+static bool ValidatePipelineCacheData(const std::vector<uint8_t>& data, const VkPhysicalDeviceProperties& properties) {
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) return false;
+    memcpy(&header, data.data(), sizeof(header));
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+        header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+        memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+// create pipeline cache with initial data
+static VkPipelineCache CreatePipelineCache(VkDevice device, const std::vector<uint8_t>& initialData) {
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = VK_NULL_HANDLE;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = initialData.size();
+    pipelineCacheCreateInfo.pInitialData = initialData.empty() ? VK_NULL_HANDLE : initialData.data();
+    VkPipelineCache pipelineCache{};
+    vkCreatePipelineCache(device, &pipelineCacheCreateInfo, VK_NULL_HANDLE, &pipelineCache);
+    return pipelineCache;
+}
+
+PipelineCache::PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& directory, bool creationFeedback) :
+    device(device), properties(properties), creationFeedback(creationFeedback) {
+    // one file per device
+    Hasher deviceHash{};
+    deviceHash.AddValue(properties.vendorID).AddValue(properties.deviceID).AddValue(properties.pipelineCacheUUID);
+    path = directory / (HashToString(deviceHash.value) + ".bin");
+
+    // load and validate file (data size of header is bounded by file size before anything is allocated)
+    std::ifstream file(path, std::ios::binary);
+    PipelineCacheFileHeader header{};
+    std::error_code errorCode{};
+    const uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+    if (file.read((char*)&header, sizeof(header)) && header.magic == PipelineCacheFileHeader{}.magic && header.version == PipelineCacheFileHeader{}.version) {
+        if (!errorCode && header.dataSize <= fileSize - sizeof(header)) initialData.resize(header.dataSize);
+        if (initialData.size() != header.dataSize || !file.read((char*)initialData.data(), initialData.size()) ||
+            Hasher().Add(initialData.data(), initialData.size()).value != header.dataHash ||
+            !ValidatePipelineCacheData(initialData, properties)) {
+            std::cout << "Pipeline cache: " << path << " is stale or corrupted, ignored" << std::endl;
+            initialData.clear();
+        }
+    }
+    mainCache = CreatePipelineCache(device, initialData);
+    if (!mainCache && !initialData.empty()) {
+        initialData.clear();
+        mainCache = CreatePipelineCache(device, initialData);
+    }
+}
+
+PipelineCache::~PipelineCache() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+    if (saveThread.joinable()) saveThread.join();
+    for (const auto& [threadId, threadCache] : threadCaches)
+        vkDestroyPipelineCache(device, threadCache, VK_NULL_HANDLE);
+    vkDestroyPipelineCache(device, mainCache, VK_NULL_HANDLE);
+}
+
+// get pipeline cache of calling thread
+VkPipelineCache PipelineCache::GetThreadCache() {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto threadCache = threadCaches.find(std::this_thread::get_id());
+    if (threadCache != threadCaches.end()) return threadCache->second;
+    VkPipelineCache pipelineCache = CreatePipelineCache(device, initialData);
+    if (pipelineCache) threadCaches.emplace(std::this_thread::get_id(), pipelineCache);
+    return pipelineCache;
+}
+
+// record pipeline creation feedback
+void PipelineCache::RecordFeedback(const VkPipelineCreationFeedback& feedback) {
+    dirty = true;
+    if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT)) return;
+    if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) {
+        hitCount++;
+        hitNs += feedback.duration;
+    } else {
+        missCount++;
+        missNs += feedback.duration;
+    }
+}
+
+// merge thread caches and save
+bool PipelineCache::Save() {
+    std::lock_guard<std::mutex> saveLock(saveMutex);
+    dirty = false;
+    if (!mainCache) return false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<VkPipelineCache> sourceCaches{};
+        for (const auto& [threadId, threadCache] : threadCaches) sourceCaches.push_back(threadCache);
+        if (!sourceCaches.empty()) vkMergePipelineCaches(device, mainCache, (uint32_t)sourceCaches.size(), sourceCaches.data());
+    }
+
+    // pipeline cache data
+    size_t dataSize{};
+    vkGetPipelineCacheData(device, mainCache, &dataSize, VK_NULL_HANDLE);
+    std::vector<uint8_t> data(dataSize);
+    if (dataSize == 0 || vkGetPipelineCacheData(device, mainCache, &dataSize, data.data()) != VK_SUCCESS) return false;
+    data.resize(dataSize);
+    PipelineCacheFileHeader header{};
+    header.dataSize = data.size();
+    header.dataHash = Hasher().Add(data.data(), data.size()).value;
+
+    // write temporary file and rename it
+    std::error_code errorCode{};
+    std::filesystem::create_directories(path.parent_path(), errorCode);
+    std::filesystem::path tempPath = path;
+    tempPath += "." + HashToString(Hasher().AddValue(std::chrono::steady_clock::now().time_since_epoch().count()).value) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)data.data(), data.size());
+        if (!file) {
+            std::cout << "Pipeline cache: can't write " << tempPath << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path, errorCode);
+    if (errorCode) {
+        std::cout << "Pipeline cache: can't write " << path << ": " << errorCode.message() << std::endl;
+        std::filesystem::remove(tempPath, errorCode);
+        return false;
+    }
+    return true;
+}
+
+// save on background thread every interval
+void PipelineCache::StartPeriodicSave(std::chrono::milliseconds interval) {
+    if (!saveThread.joinable()) saveThread = std::thread(&PipelineCache::PeriodicSaveMain, this, interval);
+}
+
+// periodic save loop: save while new pipelines were created, until stopping
+void PipelineCache::PeriodicSaveMain(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopCondition.wait_for(lock, interval, [this]() { return stopping; }))
+        if (dirty) Save();
+}
+
+// print hit/miss report
+void PipelineCache::PrintReport() const {
+    std::cout << "Pipeline cache: " << (initialData.empty() ? "empty" : std::to_string(initialData.size()) + " bytes loaded");
+    if (creationFeedback) {
+        const double hitMs = hitCount ? hitNs * 1e-6 / hitCount : 0.0;
+        const double missMs = missCount ? missNs * 1e-6 / missCount : 0.0;
+        std::cout << ", " << hitCount << " hits (" << hitMs << " ms avg), " << missCount << " misses (" << missMs << " ms avg)";
+        if (hitCount && missCount) std::cout << ", saved ~" << (missMs - hitMs) * hitCount << " ms";
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <condition_variable>
+#include "vulkan_loader.hpp"
+
+// persistent pipeline cache
+// file ("<directory>/<device hash>.bin") is loaded only if its header matches device vendorID, deviceID and pipelineCacheUUID
+// and its data hash is intact, every thread creates pipelines through its own cache seeded with loaded data,
+// thread caches are merged into the main cache on save (atomic: temporary file + rename)
+class PipelineCache {
+public:
+    PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::filesystem::path& directory, bool creationFeedback);
+    ~PipelineCache();
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+    // get pipeline cache of calling thread (created on first use)
+    VkPipelineCache GetThreadCache();
+    // check pipeline creation feedback is available (VK_EXT_pipeline_creation_feedback or vulkan 1.3)
+    bool HasCreationFeedback() const { return creationFeedback; }
+    // record pipeline creation feedback (hit/miss and duration)
+    void RecordFeedback(const VkPipelineCreationFeedback& feedback);
+    // merge thread caches and save, returns false on failure
+    bool Save();
+    // save on background thread every interval while new pipelines were created (stopped by destructor)
+    void StartPeriodicSave(std::chrono::milliseconds interval);
+    // print hit/miss report
+    void PrintReport() const;
+private:
+    void PeriodicSaveMain(std::chrono::milliseconds interval);
+    VkDevice device{};
+    VkPhysicalDeviceProperties properties{};
+    std::filesystem::path path{};
+    bool creationFeedback{};
+    std::vector<uint8_t> initialData{};
+    VkPipelineCache mainCache{};
+    std::mutex mutex{};                                            // thread caches
+    std::map<std::thread::id, VkPipelineCache> threadCaches{};
+    std::mutex saveMutex{};
+    std::atomic<bool> dirty{};
+    // feedback statistics
+    std::atomic<uint32_t> hitCount{};
+    std::atomic<uint32_t> missCount{};
+    std::atomic<uint64_t> hitNs{};
+    std::atomic<uint64_t> missNs{};
+    // periodic save
+    std::thread saveThread{};
+    std::mutex stopMutex{};
+    std::condition_variable stopCondition{};
+    bool stopping{};
+};
@@ -0,0 +1,197 @@
+#include "pipeline_registry.hpp"
+#include "hash.hpp"
+#include <algorithm>
+
+// pipeline request state
+enum PipelineState : int { PipelineQueued, PipelineCreating, PipelineDone };
+
+// pipeline request
+struct PipelineFuture::Entry {
+    uint64_t keyHash{};
+    VkShaderModule shaderModule{};
+    KernelLayout layout{};
+    std::shared_ptr<const std::vector<uint32_t>> code{}; // SPIR-V of shader object, null for pipeline
+    std::vector<VkSpecializationMapEntry> mapEntries{};
+    std::vector<uint8_t> data{};
+    std::atomic<int> state{ PipelineQueued };
+    std::promise<KernelProgram> promise{};
+    std::shared_future<KernelProgram> program{};
+};
+
+// bind kernel program
+void BindKernelProgram(VkCommandBuffer commandBuffer, const KernelProgram& program) {
+    if (program.shader) {
+        const VkShaderStageFlagBits stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        vkCmdBindShadersEXT(commandBuffer, 1, &stage, &program.shader);
+    } else {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, program.pipeline);
+    }
+}
+
+// check pipeline creation finished
+bool PipelineFuture::IsReady() const {
+    return entry && entry->state.load() == PipelineDone;
+}
+
+// create compute pipeline
+VkPipeline CreateKernelPipeline(VkDevice device, VkShaderModule shaderModule, VkPipelineLayout pipelineLayout, const VkSpecializationInfo* specializationInfo,
+    PipelineCache* pipelineCache, VkPipelineCreateFlags flags) {
+    // pipeline creation feedback (pipeline cache hit and duration)
+    VkPipelineCreationFeedback pipelineFeedback{};
+    VkPipelineCreationFeedback stageFeedback{};
+    VkPipelineCreationFeedbackCreateInfo feedbackCreateInfo{};
+    feedbackCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+    feedbackCreateInfo.pNext = VK_NULL_HANDLE;
+    feedbackCreateInfo.pPipelineCreationFeedback = &pipelineFeedback;
+    feedbackCreateInfo.pipelineStageCreationFeedbackCount = 1;
+    feedbackCreateInfo.pPipelineStageCreationFeedbacks = &stageFeedback;
+    // compute pipeline create info
+    VkComputePipelineCreateInfo pipelineCreateInfo{};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.pNext = pipelineCache && pipelineCache->HasCreationFeedback() ? &feedbackCreateInfo : VK_NULL_HANDLE;
+    pipelineCreateInfo.flags = flags;
+    pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineCreateInfo.stage.pNext = VK_NULL_HANDLE;
+    pipelineCreateInfo.stage.flags = 0;
+    pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineCreateInfo.stage.module = shaderModule;
+    pipelineCreateInfo.stage.pName = "main";
+    pipelineCreateInfo.stage.pSpecializationInfo = specializationInfo;
+    pipelineCreateInfo.layout = pipelineLayout;
+    pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    pipelineCreateInfo.basePipelineIndex = 0;
+    VkPipeline pipeline{};
+    vkCreateComputePipelines(device, pipelineCache ? pipelineCache->GetThreadCache() : VK_NULL_HANDLE, 1, &pipelineCreateInfo, VK_NULL_HANDLE, &pipeline);
+    if (pipeline && pipelineCache) pipelineCache->RecordFeedback(pipelineFeedback);
+    return pipeline;
+}
+
+PipelineRegistry::PipelineRegistry(VkDevice device, ThreadPool& threadPool, PipelineCache* pipelineCache, ShaderBinaryCache* shaderBinaries) :
+    device(device), threadPool(threadPool), pipelineCache(pipelineCache), shaderBinaries(shaderBinaries) {}
+
+PipelineRegistry::~PipelineRegistry() {
+    for (auto& task : tasks) task.wait();
+    for (const auto& [key, entry] : pipelines) {
+        const KernelProgram program = entry->program.get();
+        if (program.shader) vkDestroyShaderEXT(device, program.shader, VK_NULL_HANDLE);
+        vkDestroyPipeline(device, program.pipeline, VK_NULL_HANDLE);
+    }
+    for (const auto& [hash, shaderModule] : shaderModules)
+        vkDestroyShaderModule(device, shaderModule, VK_NULL_HANDLE);
+}
+
+// add shader module
+uint64_t PipelineRegistry::AddModule(const std::vector<uint32_t>& code, VkShaderModule* shaderModule) {
+    const uint64_t hash = Hasher().Add(code.data(), code.size() * sizeof(uint32_t)).value;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto cached = shaderModules.find(hash);
+    if (cached == shaderModules.end()) {
+        // shader module create info
+        VkShaderModuleCreateInfo shaderModuleCreateInfo{};
+        shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        shaderModuleCreateInfo.pNext = VK_NULL_HANDLE;
+        shaderModuleCreateInfo.flags = 0;
+        shaderModuleCreateInfo.codeSize = code.size() * sizeof(uint32_t);
+        shaderModuleCreateInfo.pCode = code.data();
+        VkShaderModule newShaderModule{};
+        vkCreateShaderModule(device, &shaderModuleCreateInfo, VK_NULL_HANDLE, &newShaderModule);
+        if (newShaderModule) cached = shaderModules.emplace(hash, newShaderModule).first;
+        // shader objects are created from SPIR-V when stored binary is missing or rejected
+        if (newShaderModule && shaderBinaries) spirv.emplace(hash, std::make_shared<const std::vector<uint32_t>>(code));
+    }
+    if (shaderModule) *shaderModule = cached == shaderModules.end() ? VK_NULL_HANDLE : cached->second;
+    return hash;
+}
+
+// request pipeline
+PipelineFuture PipelineRegistry::Request(uint64_t moduleHash, const KernelLayout& layout, const VkSpecializationInfo* specializationInfo, PipelinePriority priority) {
+    // key: module hash, layout and specialization (constant ids and data)
+    std::string key = HashToString(moduleHash);
+    key.append((const char*)&layout.pipelineLayout, sizeof(layout.pipelineLayout));
+    if (specializationInfo) {
+        for (uint32_t i = 0; i < specializationInfo->mapEntryCount; i++)
+            key.append((const char*)&specializationInfo->pMapEntries[i], sizeof(VkSpecializationMapEntry));
+        key.append((const char*)specializationInfo->pData, specializationInfo->dataSize);
+    }
+
+    PipelineFuture future{};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = pipelines.find(key);
+        if (cached != pipelines.end()) {
+            future.entry = cached->second;
+        } else {
+            auto entry = std::make_shared<PipelineFuture::Entry>();
+            auto shaderModule = shaderModules.find(moduleHash);
+            entry->shaderModule = shaderModule == shaderModules.end() ? VK_NULL_HANDLE : shaderModule->second;
+            entry->layout = layout;
+            if (specializationInfo) {
+                entry->mapEntries.assign(specializationInfo->pMapEntries, specializationInfo->pMapEntries + specializationInfo->mapEntryCount);
+                entry->data.assign((const uint8_t*)specializationInfo->pData, (const uint8_t*)specializationInfo->pData + specializationInfo->dataSize);
+            }
+            // shader object needs set layouts and push constant range, explicit pipeline layouts get pipelines
+            auto code = spirv.find(moduleHash);
+            // binary key from content only (module, layout content and specialization), key above holds per process handles
+            if (code != spirv.end() && (!layout.setLayouts.empty() || layout.pushConstantRange.size)) {
+                entry->code = code->second;
+                Hasher hasher{};
+                hasher.AddValue(moduleHash).AddValue(layout.contentHash).AddValue((uint64_t)entry->mapEntries.size());
+                for (const auto& mapEntry : entry->mapEntries) hasher.AddValue(mapEntry.constantID).AddValue(mapEntry.offset).AddValue((uint64_t)mapEntry.size);
+                entry->keyHash = hasher.Add(entry->data.data(), entry->data.size()).value;
+            }
+            entry->program = entry->promise.get_future().share();
+            pipelines.emplace(std::move(key), entry);
+            future.entry = entry;
+            Schedule(entry, priority);
+            return future;
+        }
+    }
+    if (priority == PipelinePriority::Dispatch) Prioritize(future);
+    return future;
+}
+
+// schedule creation task (mutex is held)
+void PipelineRegistry::Schedule(const std::shared_ptr<PipelineFuture::Entry>& entry, PipelinePriority priority) {
+    tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const auto& task) { return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }), tasks.end());
+    tasks.push_back(threadPool.Submit([this, entry](uint32_t) { Create(*entry); },
+        priority == PipelinePriority::Dispatch ? TaskPriority::High : TaskPriority::Normal));
+}
+
+// create requested pipeline, only first caller (task or waiting thread) creates it
+void PipelineRegistry::Create(PipelineFuture::Entry& entry) {
+    int expected = PipelineQueued;
+    if (!entry.state.compare_exchange_strong(expected, PipelineCreating)) return;
+    VkSpecializationInfo specializationInfo{};
+    specializationInfo.mapEntryCount = (uint32_t)entry.mapEntries.size();
+    specializationInfo.pMapEntries = entry.mapEntries.data();
+    specializationInfo.dataSize = entry.data.size();
+    specializationInfo.pData = entry.data.data();
+    KernelProgram program{};
+    const VkSpecializationInfo* pSpecializationInfo = entry.mapEntries.empty() ? VK_NULL_HANDLE : &specializationInfo;
+    if (entry.code) program.shader = shaderBinaries->CreateComputeShader(entry.keyHash, *entry.code, entry.layout.setLayouts, entry.layout.pushConstantRange, pSpecializationInfo);
+    // pipeline (also when shader object creation failed)
+    if (!program.shader && entry.shaderModule)
+        program.pipeline = CreateKernelPipeline(device, entry.shaderModule, entry.layout.pipelineLayout, pSpecializationInfo, pipelineCache, entry.layout.pipelineFlags);
+    entry.promise.set_value(program);
+    entry.state = PipelineDone;
+}
+
+// raise queued request to dispatch priority (second task, first one to run creates pipeline)
+void PipelineRegistry::Prioritize(const PipelineFuture& future) {
+    if (!future.entry || future.entry->state.load() != PipelineQueued) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Schedule(future.entry, PipelinePriority::Dispatch);
+}
+
+// get kernel program
+KernelProgram PipelineRegistry::Get(const PipelineFuture& future) {
+    if (!future.entry) return {};
+    Create(*future.entry);
+    return future.entry->program.get();
+}
+
+// get count of pipelines
+size_t PipelineRegistry::GetPipelineCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return pipelines.size();
+}
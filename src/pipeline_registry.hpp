@@ -0,0 +1,82 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "thread_pool.hpp"
+#include "vulkan_loader.hpp"
+#include "layout_cache.hpp"
+#include "pipeline_cache.hpp"
+#include "shader_binary_cache.hpp"
+
+// pipeline request priority: dispatch priority pipelines are created before queued background pipelines
+enum class PipelinePriority { Background, Dispatch };
+
+// create compute pipeline through calling thread's pipeline cache (may be null), returns null on failure
+VkPipeline CreateKernelPipeline(VkDevice device, VkShaderModule shaderModule, VkPipelineLayout pipelineLayout, const VkSpecializationInfo* specializationInfo,
+    PipelineCache* pipelineCache, VkPipelineCreateFlags flags = 0);
+
+// compiled kernel: compute pipeline, or compute shader object when registry creates shader objects
+struct KernelProgram {
+    VkPipeline pipeline{};
+    VkShaderEXT shader{};
+    // check kernel was created
+    explicit operator bool() const { return pipeline || shader; }
+};
+
+// bind kernel program to compute bind point
+void BindKernelProgram(VkCommandBuffer commandBuffer, const KernelProgram& program);
+
+// pipeline request handle, cheap to copy
+class PipelineFuture {
+public:
+    // check handle refers to request
+    bool IsValid() const { return entry != nullptr; }
+    // check pipeline creation finished (pipeline may still be null on failure)
+    bool IsReady() const;
+private:
+    friend class PipelineRegistry;
+    struct Entry;
+    std::shared_ptr<Entry> entry{};
+};
+
+// compute pipeline registry keyed by (SPIR-V hash, specialization constants, pipeline layout)
+// shader modules are shared by SPIR-V hash, pipelines are created once on thread pool in background,
+// callers get a future at once and wait only when they dispatch (queued request is then created on calling thread)
+// with shader binaries, kernels of reflected layouts are shader objects created from stored driver binaries (SPIR-V fallback)
+class PipelineRegistry {
+public:
+    // pipeline cache and shader binaries may be null
+    PipelineRegistry(VkDevice device, ThreadPool& threadPool, PipelineCache* pipelineCache, ShaderBinaryCache* shaderBinaries = nullptr);
+    // waits for pending creations, destroys pipelines and shader modules
+    ~PipelineRegistry();
+    PipelineRegistry(const PipelineRegistry&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+    // add shader module (created once per SPIR-V), returns SPIR-V hash, module is null on failure
+    uint64_t AddModule(const std::vector<uint32_t>& code, VkShaderModule* shaderModule = nullptr);
+    // request pipeline of module with specialization info (copied), returns immediately
+    // layout without set layouts and push constants (explicit pipeline layout) always gets a pipeline
+    PipelineFuture Request(uint64_t moduleHash, const KernelLayout& layout, const VkSpecializationInfo* specializationInfo, PipelinePriority priority);
+    // raise queued request to dispatch priority
+    void Prioritize(const PipelineFuture& future);
+    // get kernel program, waits for creation or creates queued request on calling thread, returns null on failure
+    KernelProgram Get(const PipelineFuture& future);
+    // get count of pipelines (created and pending)
+    size_t GetPipelineCount();
+private:
+    void Create(PipelineFuture::Entry& entry);
+    void Schedule(const std::shared_ptr<PipelineFuture::Entry>& entry, PipelinePriority priority);
+    VkDevice device{};
+    ThreadPool& threadPool;
+    PipelineCache* pipelineCache{};
+    ShaderBinaryCache* shaderBinaries{};
+    std::mutex mutex{};
+    std::map<uint64_t, VkShaderModule> shaderModules{};                             // SPIR-V hash -> module
+    std::map<uint64_t, std::shared_ptr<const std::vector<uint32_t>>> spirv{};      // SPIR-V hash -> code (shader objects)
+    std::map<std::string, std::shared_ptr<PipelineFuture::Entry>> pipelines{};     // key -> request
+    std::vector<std::future<void>> tasks{};                                        // scheduled creation tasks
+};
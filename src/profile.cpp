@@ -0,0 +1,115 @@
+#include "profile.hpp"
+#include <cstring>
+#include <iostream>
+
+// validation layer name
+static const char* validationLayerName = "VK_LAYER_KHRONOS_validation";
+
+// get instance create info pNext
+const void* RuntimeProfileSettings::GetInstancePNext() {
+    if (validationFeatureEnables.empty()) return VK_NULL_HANDLE;
+    validationFeatures.sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT;
+    validationFeatures.pNext = VK_NULL_HANDLE;
+    validationFeatures.enabledValidationFeatureCount = validationFeatureEnables.size();
+    validationFeatures.pEnabledValidationFeatures = validationFeatureEnables.data();
+    validationFeatures.disabledValidationFeatureCount = 0;
+    validationFeatures.pDisabledValidationFeatures = VK_NULL_HANDLE;
+    return &validationFeatures;
+}
+
+// parse profile name
+RuntimeProfile ParseRuntimeProfile(const std::string& name) {
+    if (name == "release") return RuntimeProfile::Release;
+    if (name == "debug") return RuntimeProfile::Debug;
+    if (name == "gpu-assisted") return RuntimeProfile::GpuAssisted;
+    if (name == "best-practices") return RuntimeProfile::BestPractices;
+    if (!name.empty()) std::cout << "Unknown runtime profile \"" << name << "\", using default" << std::endl;
+#ifdef _DEBUG
+    return RuntimeProfile::Debug;
+#else
+    return RuntimeProfile::Release;
+#endif
+}
+
+// get profile name
+const char* GetRuntimeProfileName(RuntimeProfile profile) {
+    switch (profile) {
+    case RuntimeProfile::Release:       return "release";
+    case RuntimeProfile::Debug:         return "debug";
+    case RuntimeProfile::GpuAssisted:   return "gpu-assisted";
+    case RuntimeProfile::BestPractices: return "best-practices";
+    }
+    return "unknown";
+}
+
+// check instance layer is installed
+static bool IsInstanceLayerAvailable(const char* layerName) {
+    uint32_t layerCount{};
+    vkEnumerateInstanceLayerProperties(&layerCount, VK_NULL_HANDLE);
+    std::vector<VkLayerProperties> layers(layerCount);
+    vkEnumerateInstanceLayerProperties(&layerCount, layers.data());
+    for (const auto& layer : layers)
+        if (strcmp(layer.layerName, layerName) == 0) return true;
+    return false;
+}
+
+// get profile settings
+RuntimeProfileSettings GetRuntimeProfileSettings(RuntimeProfile profile) {
+    RuntimeProfileSettings settings{};
+    settings.profile = profile;
+    if (profile == RuntimeProfile::Release) return settings;
+
+    // validation layer is optional: missing SDK must not break debug runs
+    if (!IsInstanceLayerAvailable(validationLayerName)) {
+        std::cout << "Validation layer is not installed, running \"" << GetRuntimeProfileName(profile) << "\" profile without it" << std::endl;
+        settings.profile = RuntimeProfile::Release;
+        return settings;
+    }
+    settings.layers.push_back(validationLayerName);
+    settings.instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    settings.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    settings.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT;
+
+    // validation features (provided by validation layer)
+    if (profile == RuntimeProfile::GpuAssisted) {
+        settings.validationFeatureEnables.push_back(VK_VALIDATION_FEATURE_ENABLE_GPU_ASSISTED_EXT);
+        settings.validationFeatureEnables.push_back(VK_VALIDATION_FEATURE_ENABLE_GPU_ASSISTED_RESERVE_BINDING_SLOT_EXT);
+    }
+    if (profile == RuntimeProfile::BestPractices) {
+        settings.validationFeatureEnables.push_back(VK_VALIDATION_FEATURE_ENABLE_BEST_PRACTICES_EXT);
+        settings.messageType |= VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    }
+    if (!settings.validationFeatureEnables.empty())
+        settings.instanceExtensions.push_back(VK_EXT_VALIDATION_FEATURES_EXTENSION_NAME);
+    return settings;
+}
+
+// create debug messenger for profile
+VkDebugUtilsMessengerEXT CreateDebugMessenger(VkInstance instance, const RuntimeProfileSettings& settings) {
+    if (settings.messageSeverity == 0) return VK_NULL_HANDLE;
+
+    // VK_EXT_DEBUG_UTILS_EXTENSION_NAME
+    VkDebugUtilsMessengerCreateInfoEXT messengerCreateInfo{};
+    messengerCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messengerCreateInfo.messageSeverity = settings.messageSeverity;
+    messengerCreateInfo.messageType = settings.messageType;
+    messengerCreateInfo.pfnUserCallback = [](
+        VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+        VkDebugUtilsMessageTypeFlagsEXT messageType,
+        const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData,
+        void* pUserData) { std::cerr << "validation layer: " << pCallbackData->pMessage << std::endl; return VK_FALSE; };
+    messengerCreateInfo.pUserData = nullptr;
+    VkDebugUtilsMessengerEXT debugUtilsMessengerEXT{};
+    auto fnCreateDebugUtilsMessengerEXT = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");
+    if (fnCreateDebugUtilsMessengerEXT != nullptr)
+        fnCreateDebugUtilsMessengerEXT(instance, &messengerCreateInfo, VK_NULL_HANDLE, &debugUtilsMessengerEXT);
+    return debugUtilsMessengerEXT;
+}
+
+// destroy debug messenger
+void DestroyDebugMessenger(VkInstance instance, VkDebugUtilsMessengerEXT messenger) {
+    if (messenger == VK_NULL_HANDLE) return;
+    auto fnDestroyDebugUtilsMessengerEXT = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+    if (fnDestroyDebugUtilsMessengerEXT)
+        fnDestroyDebugUtilsMessengerEXT(instance, messenger, VK_NULL_HANDLE);
+}
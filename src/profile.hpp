@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "vulkan_loader.hpp"
+
+// runtime profile selected at startup
+// release loads no layers and installs no messenger
+enum class RuntimeProfile {
+    Release,
+    Debug,
+    GpuAssisted,
+    BestPractices
+};
+
+// runtime profile layers, extensions and messenger settings
+struct RuntimeProfileSettings {
+    RuntimeProfile profile{};
+    std::vector<const char*> layers{};
+    std::vector<const char*> instanceExtensions{};
+    std::vector<VkValidationFeatureEnableEXT> validationFeatureEnables{};
+    VkDebugUtilsMessageSeverityFlagsEXT messageSeverity{};
+    VkDebugUtilsMessageTypeFlagsEXT messageType{};
+    VkValidationFeaturesEXT validationFeatures{};
+    // get instance create info pNext (validation features or null)
+    const void* GetInstancePNext();
+};
+
+// parse profile name ("release", "debug", "gpu-assisted", "best-practices"), empty name gives build default
+RuntimeProfile ParseRuntimeProfile(const std::string& name);
+
+// get profile name
+const char* GetRuntimeProfileName(RuntimeProfile profile);
+
+// get profile settings, validation is dropped with a message when layer is not installed
+RuntimeProfileSettings GetRuntimeProfileSettings(RuntimeProfile profile);
+
+// create debug messenger for profile, returns null handle when profile has no messenger
+VkDebugUtilsMessengerEXT CreateDebugMessenger(VkInstance instance, const RuntimeProfileSettings& settings);
+
+// destroy debug messenger
+void DestroyDebugMessenger(VkInstance instance, VkDebugUtilsMessengerEXT messenger);
@@ -0,0 +1,252 @@
+#include "queues.hpp"
+#include <map>
+#include <cassert>
+#include <algorithm>
+
+// find dedicated compute-only and transfer-only queue families
+QueueFamilies FindQueueFamilies(const std::vector<VkQueueFamilyProperties>& queueFamilies, uint32_t universalFamilyIndex) {
+    QueueFamilies families{};
+    families.universal = universalFamilyIndex;
+    families.compute = universalFamilyIndex;
+    families.transfer = universalFamilyIndex;
+    for (uint32_t i = 0; i < (uint32_t)queueFamilies.size(); i++) {
+        const VkQueueFlags flags = queueFamilies[i].queueFlags;
+        if (queueFamilies[i].queueCount == 0 || i == universalFamilyIndex) continue;
+        // compute family without graphics (async compute)
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT) && families.compute == universalFamilyIndex)
+            families.compute = i;
+        // transfer family without graphics and compute (copy engine)
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) && families.transfer == universalFamilyIndex)
+            families.transfer = i;
+    }
+
+    // assign queue indices: roles in the same family get next queue while family has one
+    std::map<uint32_t, uint32_t> usedQueues{};
+    auto nextQueueIndex = [&](uint32_t family) { return std::min(usedQueues[family]++, queueFamilies[family].queueCount - 1); };
+    families.universalQueueIndex = nextQueueIndex(families.universal);
+    families.computeQueueIndex = nextQueueIndex(families.compute);
+    families.uploadQueueIndex = nextQueueIndex(families.transfer);
+    families.readbackQueueIndex = nextQueueIndex(families.transfer);
+    return families;
+}
+
+// get unique queue family indices
+std::vector<uint32_t> GetUniqueQueueFamilies(const QueueFamilies& families) {
+    std::vector<uint32_t> uniqueFamilies{ families.universal };
+    if (families.compute != families.universal) uniqueFamilies.push_back(families.compute);
+    if (families.transfer != families.universal && families.transfer != families.compute) uniqueFamilies.push_back(families.transfer);
+    return uniqueFamilies;
+}
+
+// build queue create infos for all unique families
+std::vector<VkDeviceQueueCreateInfo> BuildQueueCreateInfos(const QueueFamilies& families, const float* queuePriorities) {
+    // queue count per family is highest used queue index + 1
+    std::map<uint32_t, uint32_t> queueCounts{};
+    auto useQueue = [&](uint32_t family, uint32_t index) { queueCounts[family] = std::max(queueCounts[family], index + 1); };
+    useQueue(families.universal, families.universalQueueIndex);
+    useQueue(families.compute, families.computeQueueIndex);
+    useQueue(families.transfer, families.uploadQueueIndex);
+    useQueue(families.transfer, families.readbackQueueIndex);
+
+    // device queue create infos
+    std::vector<VkDeviceQueueCreateInfo> deviceQueueCreateInfos{};
+    for (const auto& [family, queueCount] : queueCounts) {
+        VkDeviceQueueCreateInfo deviceQueueCreateInfo{};
+        deviceQueueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        deviceQueueCreateInfo.pNext = VK_NULL_HANDLE;
+        deviceQueueCreateInfo.flags = 0;
+        deviceQueueCreateInfo.queueFamilyIndex = family;
+        deviceQueueCreateInfo.queueCount = queueCount;
+        deviceQueueCreateInfo.pQueuePriorities = queuePriorities;
+        deviceQueueCreateInfos.push_back(deviceQueueCreateInfo);
+    }
+    return deviceQueueCreateInfos;
+}
+
+// get device queues created with BuildQueueCreateInfos
+DeviceQueues GetDeviceQueues(VkDevice device, const QueueFamilies& families) {
+    DeviceQueues queues{};
+    queues.families = families;
+    vkGetDeviceQueue(device, families.universal, families.universalQueueIndex, &queues.universal);
+    vkGetDeviceQueue(device, families.compute, families.computeQueueIndex, &queues.compute);
+    vkGetDeviceQueue(device, families.transfer, families.uploadQueueIndex, &queues.upload);
+    vkGetDeviceQueue(device, families.transfer, families.readbackQueueIndex, &queues.readback);
+    assert(queues.universal && queues.compute && queues.upload && queues.readback);
+    return queues;
+}
+
+// upload -> dispatch -> readback executor
+AsyncComputeExecutor::AsyncComputeExecutor(VkDevice device, const DeviceQueues& queues, uint32_t framesInFlight, bool timelineSemaphore) :
+    device(device), queues(queues), frames(framesInFlight) {
+    // command pool per stage (stage queue family)
+    const uint32_t stageFamilies[STAGE_COUNT] = { queues.families.transfer, queues.families.compute, queues.families.transfer };
+    for (uint32_t stage = 0; stage < STAGE_COUNT; stage++) {
+        VkCommandPoolCreateInfo commandPoolCreateInfo{};
+        commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        commandPoolCreateInfo.pNext = VK_NULL_HANDLE;
+        commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        commandPoolCreateInfo.queueFamilyIndex = stageFamilies[stage];
+        vkCreateCommandPool(device, &commandPoolCreateInfo, VK_NULL_HANDLE, &commandPools[stage]);
+        assert(commandPools[stage]);
+    }
+
+    // frame command buffers, semaphores and fences
+    for (auto& frame : frames) {
+        for (uint32_t stage = 0; stage < STAGE_COUNT; stage++) {
+            VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+            commandBufferAllocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            commandBufferAllocateInfo.pNext = VK_NULL_HANDLE;
+            commandBufferAllocateInfo.commandPool = commandPools[stage];
+            commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            commandBufferAllocateInfo.commandBufferCount = 1;
+            vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &frame.commandBuffers[stage]);
+            assert(frame.commandBuffers[stage]);
+        }
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = VK_NULL_HANDLE;
+        semaphoreCreateInfo.flags = 0;
+        vkCreateSemaphore(device, &semaphoreCreateInfo, VK_NULL_HANDLE, &frame.uploadComplete);
+        vkCreateSemaphore(device, &semaphoreCreateInfo, VK_NULL_HANDLE, &frame.dispatchComplete);
+        assert(frame.uploadComplete && frame.dispatchComplete);
+        VkFenceCreateInfo fenceCreateInfo{};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.pNext = VK_NULL_HANDLE;
+        fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        vkCreateFence(device, &fenceCreateInfo, VK_NULL_HANDLE, &frame.fence);
+        assert(frame.fence);
+    }
+
+    // job timeline (value of last completed job)
+    if (timelineSemaphore) {
+        VkSemaphoreTypeCreateInfo semaphoreTypeCreateInfo{};
+        semaphoreTypeCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        semaphoreTypeCreateInfo.pNext = VK_NULL_HANDLE;
+        semaphoreTypeCreateInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        semaphoreTypeCreateInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreCreateInfo{};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+        semaphoreCreateInfo.flags = 0;
+        vkCreateSemaphore(device, &semaphoreCreateInfo, VK_NULL_HANDLE, &timeline);
+        assert(timeline);
+    }
+}
+
+AsyncComputeExecutor::~AsyncComputeExecutor() {
+    WaitIdle();
+    for (auto& frame : frames) {
+        vkDestroyFence(device, frame.fence, VK_NULL_HANDLE);
+        vkDestroySemaphore(device, frame.dispatchComplete, VK_NULL_HANDLE);
+        vkDestroySemaphore(device, frame.uploadComplete, VK_NULL_HANDLE);
+    }
+    if (timeline) vkDestroySemaphore(device, timeline, VK_NULL_HANDLE);
+    for (uint32_t stage = 0; stage < STAGE_COUNT; stage++)
+        vkDestroyCommandPool(device, commandPools[stage], VK_NULL_HANDLE);
+}
+
+// record and submit job
+uint64_t AsyncComputeExecutor::Submit(const RecordFunc& recordUpload, const RecordFunc& recordDispatch, const RecordFunc& recordReadback) {
+    // wait frame slot
+    Frame& frame = frames[frameIndex];
+    frameIndex = (frameIndex + 1) % (uint32_t)frames.size();
+    vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(device, 1, &frame.fence);
+    frame.value = submitValue + 1;
+
+    // record stage command buffers
+    const RecordFunc* recordFuncs[STAGE_COUNT] = { &recordUpload, &recordDispatch, &recordReadback };
+    for (uint32_t stage = 0; stage < STAGE_COUNT; stage++) {
+        VkCommandBuffer commandBuffer = frame.commandBuffers[stage];
+        vkResetCommandBuffer(commandBuffer, 0);
+        VkCommandBufferBeginInfo commandBufferBeginInfo{};
+        commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        commandBufferBeginInfo.pNext = VK_NULL_HANDLE;
+        commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        commandBufferBeginInfo.pInheritanceInfo = VK_NULL_HANDLE;
+        vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+        if (*recordFuncs[stage]) (*recordFuncs[stage])(commandBuffer);
+        vkEndCommandBuffer(commandBuffer);
+    }
+
+    // submit infos: upload signals dispatch, dispatch signals readback, readback signals frame fence
+    const VkPipelineStageFlags dispatchWaitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    const VkPipelineStageFlags readbackWaitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    VkSubmitInfo submitInfos[STAGE_COUNT]{};
+    for (uint32_t stage = 0; stage < STAGE_COUNT; stage++) {
+        submitInfos[stage].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfos[stage].pNext = VK_NULL_HANDLE;
+        submitInfos[stage].commandBufferCount = 1;
+        submitInfos[stage].pCommandBuffers = &frame.commandBuffers[stage];
+    }
+    submitInfos[STAGE_UPLOAD].signalSemaphoreCount = 1;
+    submitInfos[STAGE_UPLOAD].pSignalSemaphores = &frame.uploadComplete;
+    submitInfos[STAGE_DISPATCH].waitSemaphoreCount = 1;
+    submitInfos[STAGE_DISPATCH].pWaitSemaphores = &frame.uploadComplete;
+    submitInfos[STAGE_DISPATCH].pWaitDstStageMask = &dispatchWaitStage;
+    submitInfos[STAGE_DISPATCH].signalSemaphoreCount = 1;
+    submitInfos[STAGE_DISPATCH].pSignalSemaphores = &frame.dispatchComplete;
+    submitInfos[STAGE_READBACK].waitSemaphoreCount = 1;
+    submitInfos[STAGE_READBACK].pWaitSemaphores = &frame.dispatchComplete;
+    submitInfos[STAGE_READBACK].pWaitDstStageMask = &readbackWaitStage;
+    // readback signals job value
+    VkTimelineSemaphoreSubmitInfo timelineSemaphoreSubmitInfo{};
+    timelineSemaphoreSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineSemaphoreSubmitInfo.pNext = VK_NULL_HANDLE;
+    timelineSemaphoreSubmitInfo.signalSemaphoreValueCount = 1;
+    timelineSemaphoreSubmitInfo.pSignalSemaphoreValues = &frame.value;
+    if (timeline) {
+        submitInfos[STAGE_READBACK].pNext = &timelineSemaphoreSubmitInfo;
+        submitInfos[STAGE_READBACK].signalSemaphoreCount = 1;
+        submitInfos[STAGE_READBACK].pSignalSemaphores = &timeline;
+    }
+    submitValue = frame.value;
+
+    // single queue fallback: one batch, semaphores keep stage order
+    if (queues.upload == queues.compute && queues.readback == queues.compute) {
+        vkQueueSubmit(queues.compute, STAGE_COUNT, submitInfos, frame.fence);
+        return submitValue;
+    }
+    vkQueueSubmit(queues.upload, 1, &submitInfos[STAGE_UPLOAD], VK_NULL_HANDLE);
+    vkQueueSubmit(queues.compute, 1, &submitInfos[STAGE_DISPATCH], VK_NULL_HANDLE);
+    vkQueueSubmit(queues.readback, 1, &submitInfos[STAGE_READBACK], frame.fence);
+    return submitValue;
+}
+
+// get value of last completed job
+uint64_t AsyncComputeExecutor::GetCompletedValue() const {
+    if (timeline) {
+        uint64_t value{};
+        vkGetSemaphoreCounterValue(device, timeline, &value);
+        return value;
+    }
+    // jobs before oldest unsignaled frame fence completed
+    uint64_t value = submitValue;
+    for (const auto& frame : frames)
+        if (frame.value && frame.value <= value && vkGetFenceStatus(device, frame.fence) != VK_SUCCESS) value = frame.value - 1;
+    return value;
+}
+
+// wait until job of value completed
+void AsyncComputeExecutor::Wait(uint64_t value) {
+    value = std::min(value, submitValue);
+    if (timeline) {
+        VkSemaphoreWaitInfo semaphoreWaitInfo{};
+        semaphoreWaitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        semaphoreWaitInfo.pNext = VK_NULL_HANDLE;
+        semaphoreWaitInfo.flags = 0;
+        semaphoreWaitInfo.semaphoreCount = 1;
+        semaphoreWaitInfo.pSemaphores = &timeline;
+        semaphoreWaitInfo.pValues = &value;
+        vkWaitSemaphores(device, &semaphoreWaitInfo, UINT64_MAX);
+        return;
+    }
+    for (auto& frame : frames)
+        if (frame.value && frame.value <= value) vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+}
+
+// wait all submitted jobs
+void AsyncComputeExecutor::WaitIdle() {
+    for (auto& frame : frames)
+        vkWaitForFences(device, 1, &frame.fence, VK_TRUE, UINT64_MAX);
+}
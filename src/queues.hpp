@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include "vulkan_loader.hpp"
+
+// queue families and queue indices used by application
+// compute and transfer fall back to universal family when device has no dedicated families,
+// roles sharing a family get separate queues while family has enough of them
+struct QueueFamilies {
+    uint32_t universal = VK_QUEUE_FAMILY_IGNORED;
+    uint32_t compute = VK_QUEUE_FAMILY_IGNORED;
+    uint32_t transfer = VK_QUEUE_FAMILY_IGNORED;
+    uint32_t universalQueueIndex{};
+    uint32_t computeQueueIndex{};
+    uint32_t uploadQueueIndex{};
+    uint32_t readbackQueueIndex{};
+};
+
+// device queues: upload and readback use separate transfer queues when transfer family has enough queues
+struct DeviceQueues {
+    QueueFamilies families{};
+    VkQueue universal{};
+    VkQueue compute{};
+    VkQueue upload{};
+    VkQueue readback{};
+};
+
+// find dedicated compute-only and transfer-only queue families
+QueueFamilies FindQueueFamilies(const std::vector<VkQueueFamilyProperties>& queueFamilies, uint32_t universalFamilyIndex);
+
+// get unique queue family indices (for VK_SHARING_MODE_CONCURRENT resources)
+std::vector<uint32_t> GetUniqueQueueFamilies(const QueueFamilies& families);
+
+// build queue create infos for all unique families, priorities must live until vkCreateDevice
+std::vector<VkDeviceQueueCreateInfo> BuildQueueCreateInfos(const QueueFamilies& families, const float* queuePriorities);
+
+// get device queues created with BuildQueueCreateInfos
+DeviceQueues GetDeviceQueues(VkDevice device, const QueueFamilies& families);
+
+// upload -> dispatch -> readback executor
+// stages are submitted to transfer, compute and transfer queues and chained by semaphores,
+// so upload of the next job overlaps dispatch of the current one
+// jobs are numbered from 1 in submission order, readback signals job value on timeline semaphore (timelineSemaphore devices),
+// otherwise completed values are derived from frame fences, so resources of a job can be released against its value
+class AsyncComputeExecutor {
+public:
+    using RecordFunc = std::function<void(VkCommandBuffer)>;
+    AsyncComputeExecutor(VkDevice device, const DeviceQueues& queues, uint32_t framesInFlight = 2, bool timelineSemaphore = false);
+    ~AsyncComputeExecutor();
+    AsyncComputeExecutor(const AsyncComputeExecutor&) = delete;
+    AsyncComputeExecutor& operator=(const AsyncComputeExecutor&) = delete;
+
+    // record and submit job, blocks only when all frames are in flight, returns job value
+    uint64_t Submit(const RecordFunc& recordUpload, const RecordFunc& recordDispatch, const RecordFunc& recordReadback);
+    // get value of next job (recording callbacks run before Submit returns it)
+    uint64_t GetNextValue() const { return submitValue + 1; }
+    // get value of last job known to be complete, jobs complete in submission order (does not block)
+    uint64_t GetCompletedValue() const;
+    // wait until job of value completed
+    void Wait(uint64_t value);
+    // wait all submitted jobs
+    void WaitIdle();
+private:
+    enum Stage { STAGE_UPLOAD, STAGE_DISPATCH, STAGE_READBACK, STAGE_COUNT };
+    struct Frame {
+        VkCommandBuffer commandBuffers[STAGE_COUNT]{};
+        VkSemaphore uploadComplete{};
+        VkSemaphore dispatchComplete{};
+        VkFence fence{};
+        uint64_t value{};
+    };
+    VkDevice device{};
+    DeviceQueues queues{};
+    VkCommandPool commandPools[STAGE_COUNT]{};
+    std::vector<Frame> frames{};
+    uint32_t frameIndex{};
+    VkSemaphore timeline{};
+    uint64_t submitValue{};
+};
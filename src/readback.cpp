@@ -0,0 +1,79 @@
+#include "readback.hpp"
+#include <algorithm>
+#undef VMA_IMPLEMENTATION // allocator implementation is compiled in main.cpp
+#include <vma/VmaUsage.h>
+
+ReadbackQueue::ReadbackQueue(VkBuffer buffer, void* mappedData, VkDeviceSize size, VmaAllocator allocator, VmaAllocation allocation, bool coherent,
+    VkDeviceSize nonCoherentAtomSize) :
+    ring(buffer, mappedData, size), allocator(allocator), allocation(allocation), coherent(coherent), nonCoherentAtomSize(std::max<VkDeviceSize>(1, nonCoherentAtomSize)) {}
+
+// allocate range of readback (ranges of delivered readbacks are reused first)
+StagingAllocation ReadbackQueue::Allocate(VkDeviceSize size) {
+    // ranges start at atom boundaries, invalidation of one range does not touch bytes of another being written
+    return ring.Allocate(size, coherent ? 0 : nonCoherentAtomSize);
+}
+
+// copy writes visible to host reads after job completed
+void ReadbackQueue::RecordHostBarrier(VkCommandBuffer commandBuffer) const {
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = VK_NULL_HANDLE;
+    memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+}
+
+// record copy of buffer range
+bool ReadbackQueue::ReadBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, DeliverFunc deliver) {
+    StagingAllocation allocation = Allocate(size);
+    if (!allocation) return false;
+    const VkBufferCopy bufferCopy{ offset, allocation.offset, size };
+    vkCmdCopyBuffer(commandBuffer, buffer, allocation.buffer, 1, &bufferCopy);
+    RecordHostBarrier(commandBuffer);
+    pendingReadbacks.push_back({ allocation, std::move(deliver) });
+    return true;
+}
+
+// record copy of color image
+bool ReadbackQueue::ReadImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, VkExtent3D extent, uint32_t texelSize, DeliverFunc deliver) {
+    StagingAllocation allocation = Allocate((VkDeviceSize)extent.width * extent.height * extent.depth * texelSize);
+    if (!allocation) return false;
+    VkBufferImageCopy bufferImageCopy{};
+    bufferImageCopy.bufferOffset = allocation.offset;
+    bufferImageCopy.bufferRowLength = 0;
+    bufferImageCopy.bufferImageHeight = 0;
+    bufferImageCopy.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    bufferImageCopy.imageOffset = { 0, 0, 0 };
+    bufferImageCopy.imageExtent = extent;
+    vkCmdCopyImageToBuffer(commandBuffer, image, imageLayout, allocation.buffer, 1, &bufferImageCopy);
+    RecordHostBarrier(commandBuffer);
+    pendingReadbacks.push_back({ allocation, std::move(deliver) });
+    return true;
+}
+
+// release readbacks recorded since previous release
+void ReadbackQueue::Release(uint64_t value) {
+    for (auto pending = pendingReadbacks.rbegin(); pending != pendingReadbacks.rend() && pending->value == UINT64_MAX; ++pending)
+        pending->value = value;
+    ring.Release(value);
+}
+
+// invalidate mapping over range (non coherent memory only, VMA rounds range to atom size within allocation)
+void ReadbackQueue::Invalidate(const StagingAllocation& range) const {
+    if (coherent) return;
+    vmaInvalidateAllocation(allocator, allocation, range.offset, range.size);
+}
+
+// deliver readbacks of completed jobs in release order
+uint32_t ReadbackQueue::Poll(uint64_t completedValue) {
+    uint32_t deliveredCount = 0;
+    while (!pendingReadbacks.empty() && pendingReadbacks.front().value <= completedValue) {
+        PendingReadback& pending = pendingReadbacks.front();
+        Invalidate(pending.allocation);
+        if (pending.deliver) pending.deliver(pending.allocation.data, pending.allocation.size);
+        pendingReadbacks.pop_front();
+        deliveredCount++;
+    }
+    ring.Reclaim(completedValue);
+    return deliveredCount;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <deque>
+#include <cstdint>
+#include <functional>
+#include "vulkan_loader.hpp"
+#include "staging_ring.hpp"
+
+// VMA handles (vk_mem_alloc.h), declared here so includers don't need the allocator header
+VK_DEFINE_HANDLE(VmaAllocator)
+VK_DEFINE_HANDLE(VmaAllocation)
+
+// asynchronous readback: copies of device results into a persistently mapped host cached buffer (random host access),
+// ranges are suballocated from a staging ring, released against the executor job value which records the copies,
+// and delivered to callbacks from Poll once that value completed (timeline semaphore or fence, no queue wait idle),
+// non coherent memory is invalidated only over delivered ranges (used by one recording thread)
+class ReadbackQueue {
+public:
+    using DeliverFunc = std::function<void(const void* data, VkDeviceSize size)>;
+    // buffer: transfer destination, host visible (preferably cached), persistently mapped by caller,
+    // allocation is its VMA allocation (bound at offset zero) invalidated per delivered range, nonCoherentAtomSize of device limits
+    ReadbackQueue(VkBuffer buffer, void* mappedData, VkDeviceSize size, VmaAllocator allocator, VmaAllocation allocation, bool coherent, VkDeviceSize nonCoherentAtomSize);
+    ReadbackQueue(const ReadbackQueue&) = delete;
+    ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+    // record copy of buffer range, returns false when ring has no room until pending readbacks are delivered
+    bool ReadBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size, DeliverFunc deliver);
+    // record copy of color image (general or transfer source layout) with tightly packed texels of texelSize bytes
+    bool ReadImage(VkCommandBuffer commandBuffer, VkImage image, VkImageLayout imageLayout, VkExtent3D extent, uint32_t texelSize, DeliverFunc deliver);
+    // release readbacks recorded since previous release against job value
+    void Release(uint64_t value);
+    // deliver readbacks of jobs up to completed value, returns count of delivered readbacks
+    uint32_t Poll(uint64_t completedValue);
+    // get count of readbacks not delivered yet
+    size_t GetPendingCount() const { return pendingReadbacks.size(); }
+private:
+    struct PendingReadback {
+        StagingAllocation allocation{};
+        DeliverFunc deliver{};
+        uint64_t value = UINT64_MAX;  // job value, UINT64_MAX until released
+    };
+    StagingAllocation Allocate(VkDeviceSize size);
+    void RecordHostBarrier(VkCommandBuffer commandBuffer) const;
+    void Invalidate(const StagingAllocation& range) const;
+    StagingRing ring;
+    VmaAllocator allocator{};
+    VmaAllocation allocation{};
+    bool coherent{};
+    VkDeviceSize nonCoherentAtomSize{};
+    std::deque<PendingReadback> pendingReadbacks{};
+};
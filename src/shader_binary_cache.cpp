@@ -0,0 +1,174 @@
+#include "shader_binary_cache.hpp"
+#include "hash.hpp"
+#include "bench.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+// shader binary file header, followed by entries (key, size, binary data)
+struct ShaderBinaryFileHeader {
+    uint32_t magic = 0x4f53564b; // "KVSO"
+    uint32_t version = 1;
+    uint64_t deviceHash{};       // vendorID, deviceID, shaderBinaryUUID and shaderBinaryVersion
+    uint64_t entryCount{};
+    uint64_t dataSize{};
+    uint64_t dataHash{};
+};
+
+// shader binary file entry header
+struct ShaderBinaryFileEntry {
+    uint64_t key{};
+    uint64_t size{};
+};
+
+ShaderBinaryCache::ShaderBinaryCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const DeviceCapabilities& capabilities, const std::filesystem::path& directory) :
+    device(device) {
+    // one file per device and binary version
+    Hasher hasher{};
+    hasher.AddValue(properties.vendorID).AddValue(properties.deviceID).AddValue(capabilities.shaderBinaryUUID).AddValue(capabilities.shaderBinaryVersion);
+    deviceHash = hasher.value;
+    path = directory / (HashToString(deviceHash) + ".shaders");
+
+    // load and validate file (data size of header is bounded by file size before anything is allocated)
+    std::ifstream file(path, std::ios::binary);
+    ShaderBinaryFileHeader header{};
+    if (!file.read((char*)&header, sizeof(header))) return;
+    std::error_code errorCode{};
+    const uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+    const bool validHeader = header.magic == ShaderBinaryFileHeader{}.magic && header.version == ShaderBinaryFileHeader{}.version &&
+        !errorCode && header.dataSize <= fileSize - sizeof(header);
+    std::vector<uint8_t> data(validHeader ? header.dataSize : 0);
+    if (data.empty() || header.deviceHash != deviceHash || !file.read((char*)data.data(), data.size()) ||
+        Hasher().Add(data.data(), data.size()).value != header.dataHash) {
+        std::cout << "Shader binaries: " << path << " is stale or corrupted, ignored" << std::endl;
+        return;
+    }
+    size_t offset = 0;
+    for (uint64_t i = 0; i < header.entryCount; i++) {
+        ShaderBinaryFileEntry entry{};
+        if (offset + sizeof(entry) > data.size()) break;
+        memcpy(&entry, data.data() + offset, sizeof(entry));
+        offset += sizeof(entry);
+        if (entry.size > data.size() - offset) break;
+        Binary& binary = binaries[entry.key];
+        binary.chunks.resize((entry.size + sizeof(BinaryChunk) - 1) / sizeof(BinaryChunk));
+        binary.size = entry.size;
+        memcpy(binary.chunks.data(), data.data() + offset, entry.size);
+        offset += entry.size;
+    }
+    loadedCount = binaries.size();
+}
+
+// create compute shader object
+VkShaderEXT ShaderBinaryCache::CreateComputeShader(uint64_t key, const std::vector<uint32_t>& code, const std::vector<VkDescriptorSetLayout>& setLayouts,
+    const VkPushConstantRange& pushConstantRange, const VkSpecializationInfo* specializationInfo) {
+    // shader create info (stored binary first)
+    VkShaderCreateInfoEXT shaderCreateInfo{};
+    shaderCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT;
+    shaderCreateInfo.pNext = VK_NULL_HANDLE;
+    shaderCreateInfo.flags = 0;
+    shaderCreateInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    shaderCreateInfo.nextStage = 0;
+    shaderCreateInfo.codeType = VK_SHADER_CODE_TYPE_BINARY_EXT;
+    shaderCreateInfo.codeSize = 0;
+    shaderCreateInfo.pCode = VK_NULL_HANDLE;
+    shaderCreateInfo.pName = "main";
+    shaderCreateInfo.setLayoutCount = (uint32_t)setLayouts.size();
+    shaderCreateInfo.pSetLayouts = setLayouts.data();
+    shaderCreateInfo.pushConstantRangeCount = pushConstantRange.size ? 1 : 0;
+    shaderCreateInfo.pPushConstantRanges = &pushConstantRange;
+    shaderCreateInfo.pSpecializationInfo = specializationInfo;
+
+    // stored binary (copied: map may be modified by other threads while driver reads it)
+    Binary binary{};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto cached = binaries.find(key);
+        if (cached != binaries.end()) binary = cached->second;
+    }
+    VkShaderEXT shader{};
+    if (binary.size) {
+        Stopwatch stopwatch{};
+        shaderCreateInfo.codeSize = binary.size;
+        shaderCreateInfo.pCode = binary.chunks.data();
+        if (vkCreateShadersEXT(device, 1, &shaderCreateInfo, VK_NULL_HANDLE, &shader) == VK_SUCCESS && shader) {
+            hitCount++;
+            hitNs += (uint64_t)stopwatch.ElapsedNs();
+            return shader;
+        }
+        // VK_INCOMPATIBLE_SHADER_BINARY_EXT: driver update or binary of other device, SPIR-V fallback
+        rejectCount++;
+        shader = VK_NULL_HANDLE;
+    }
+
+    // SPIR-V
+    Stopwatch stopwatch{};
+    shaderCreateInfo.codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT;
+    shaderCreateInfo.codeSize = code.size() * sizeof(uint32_t);
+    shaderCreateInfo.pCode = code.data();
+    if (vkCreateShadersEXT(device, 1, &shaderCreateInfo, VK_NULL_HANDLE, &shader) != VK_SUCCESS || !shader) return VK_NULL_HANDLE;
+    compileCount++;
+    compileNs += (uint64_t)stopwatch.ElapsedNs();
+
+    // store binary of created shader
+    size_t size{};
+    vkGetShaderBinaryDataEXT(device, shader, &size, VK_NULL_HANDLE);
+    binary.chunks.resize((size + sizeof(BinaryChunk) - 1) / sizeof(BinaryChunk));
+    if (size && vkGetShaderBinaryDataEXT(device, shader, &size, binary.chunks.data()) == VK_SUCCESS) {
+        binary.size = size;
+        std::lock_guard<std::mutex> lock(mutex);
+        binaries[key] = std::move(binary);
+        dirty = true;
+    }
+    return shader;
+}
+
+// save binaries
+bool ShaderBinaryCache::Save() {
+    std::vector<uint8_t> data{};
+    ShaderBinaryFileHeader header{};
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!dirty) return true;
+        dirty = false;
+        for (const auto& [key, binary] : binaries) {
+            const ShaderBinaryFileEntry entry{ key, binary.size };
+            data.insert(data.end(), (const uint8_t*)&entry, (const uint8_t*)&entry + sizeof(entry));
+            data.insert(data.end(), (const uint8_t*)binary.chunks.data(), (const uint8_t*)binary.chunks.data() + binary.size);
+        }
+        header.entryCount = binaries.size();
+    }
+    header.deviceHash = deviceHash;
+    header.dataSize = data.size();
+    header.dataHash = Hasher().Add(data.data(), data.size()).value;
+
+    // write temporary file and rename it
+    std::error_code errorCode{};
+    std::filesystem::create_directories(path.parent_path(), errorCode);
+    std::filesystem::path tempPath = path;
+    tempPath += "." + HashToString(Hasher().AddValue(std::chrono::steady_clock::now().time_since_epoch().count()).value) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)data.data(), data.size());
+        if (!file) {
+            std::cout << "Shader binaries: can't write " << tempPath << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path, errorCode);
+    if (errorCode) {
+        std::cout << "Shader binaries: can't write " << path << ": " << errorCode.message() << std::endl;
+        std::filesystem::remove(tempPath, errorCode);
+        return false;
+    }
+    return true;
+}
+
+// print binary hit/reject/compile report
+void ShaderBinaryCache::PrintReport() const {
+    std::cout << "Shader binaries: " << loadedCount << " loaded";
+    std::cout << ", " << hitCount << " created from binary (" << (hitCount ? hitNs * 1e-6 / hitCount : 0.0) << " ms avg)";
+    std::cout << ", " << rejectCount << " rejected";
+    std::cout << ", " << compileCount << " compiled from SPIR-V (" << (compileCount ? compileNs * 1e-6 / compileCount : 0.0) << " ms avg)" << std::endl;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include "vulkan_loader.hpp"
+#include "capabilities.hpp"
+
+// persistent compute shader object binaries (VK_EXT_shader_object)
+// file ("<directory>/<device hash>.shaders") is loaded only if its header matches device vendorID, deviceID,
+// shaderBinaryUUID and shaderBinaryVersion and its data hash is intact, shaders are created from stored binaries
+// (no compilation), binaries rejected by driver and new shaders are created from SPIR-V and their binaries stored
+class ShaderBinaryCache {
+public:
+    ShaderBinaryCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const DeviceCapabilities& capabilities, const std::filesystem::path& directory);
+    ShaderBinaryCache(const ShaderBinaryCache&) = delete;
+    ShaderBinaryCache& operator=(const ShaderBinaryCache&) = delete;
+    // create compute shader object (key covers SPIR-V, layout and specialization), returns null on failure
+    VkShaderEXT CreateComputeShader(uint64_t key, const std::vector<uint32_t>& code, const std::vector<VkDescriptorSetLayout>& setLayouts,
+        const VkPushConstantRange& pushConstantRange, const VkSpecializationInfo* specializationInfo);
+    // save binaries when new ones were stored, returns false on failure
+    bool Save();
+    // print binary hit/reject/compile report
+    void PrintReport() const;
+private:
+    // shader binary (16 byte aligned as required by vkCreateShadersEXT)
+    struct alignas(16) BinaryChunk { uint8_t bytes[16]; };
+    struct Binary {
+        std::vector<BinaryChunk> chunks{};
+        size_t size{};
+    };
+    VkDevice device{};
+    std::filesystem::path path{};
+    uint64_t deviceHash{};
+    std::mutex mutex{};
+    std::map<uint64_t, Binary> binaries{};
+    bool dirty{};
+    size_t loadedCount{};
+    std::atomic<uint32_t> hitCount{};
+    std::atomic<uint32_t> rejectCount{};
+    std::atomic<uint32_t> compileCount{};
+    std::atomic<uint64_t> hitNs{};
+    std::atomic<uint64_t> compileNs{};
+};
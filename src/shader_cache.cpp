@@ -0,0 +1,176 @@
+#include "shader_cache.hpp"
+#include "hash.hpp"
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+// cache entry header
+struct SpirvCacheHeader {
+    uint32_t magic = 0x43565053; // "SPVC"
+    uint32_t version = 3;
+    uint64_t key{};
+    uint64_t codeSize{};         // in words
+    uint64_t includeCount{};     // include records after code
+};
+
+// cache entry include record, followed by name, includer and requested name strings
+struct SpirvCacheInclude {
+    uint32_t nameSize{};
+    uint32_t includerSize{};
+    uint64_t contentHash{};
+    uint32_t requestedSize{};
+    uint32_t relative{};
+};
+
+SpirvCache::SpirvCache(const std::filesystem::path& directory, uint64_t maxSize) : directory(directory), maxSize(maxSize) {
+    std::error_code errorCode{};
+    std::filesystem::create_directories(directory, errorCode);
+    if (errorCode) std::cout << "SPIR-V cache: can't create " << directory << ": " << errorCode.message() << std::endl;
+}
+
+// compute cache key from source, compile options and compiler version
+uint64_t SpirvCache::ComputeKey(std::string_view source, const ShaderCompileOptions& options) {
+    static const std::string shadercVersion = GetShadercVersion();
+    return Hasher().Add(source).Add(options.GetKey()).Add(shadercVersion).value;
+}
+
+// load entry
+std::vector<uint32_t> SpirvCache::Load(uint64_t key, const ShaderIncludeResolver* resolver, std::vector<ShaderInclude>* includes) {
+    const std::filesystem::path path = directory / (HashToString(key) + ".spv");
+    std::ifstream file(path, std::ios::binary);
+    SpirvCacheHeader header{};
+    std::vector<uint32_t> code{};
+    std::vector<ShaderInclude> entryIncludes{};
+    // code size of header is bounded by file size before anything is allocated
+    std::error_code errorCode{};
+    const uintmax_t fileSize = std::filesystem::file_size(path, errorCode);
+    if (file.read((char*)&header, sizeof(header)) && header.magic == SpirvCacheHeader{}.magic &&
+        header.version == SpirvCacheHeader{}.version && header.key == key && header.codeSize > 0 &&
+        !errorCode && header.codeSize <= (fileSize - sizeof(header)) / sizeof(uint32_t)) {
+        code.resize(header.codeSize);
+        if (!file.read((char*)code.data(), code.size() * sizeof(uint32_t))) code.clear();
+        for (uint64_t i = 0; i < header.includeCount && !code.empty(); i++) {
+            SpirvCacheInclude record{};
+            ShaderInclude include{};
+            // string sizes are bounded by bytes left in file
+            if (!file.read((char*)&record, sizeof(record)) ||
+                (uint64_t)record.nameSize + record.includerSize + record.requestedSize > fileSize - (uintmax_t)file.tellg()) {
+                code.clear();
+                break;
+            }
+            include.name.resize(record.nameSize);
+            include.includer.resize(record.includerSize);
+            include.contentHash = record.contentHash;
+            include.requested.resize(record.requestedSize);
+            include.relative = record.relative != 0;
+            if (!file.read(include.name.data(), include.name.size()) || !file.read(include.includer.data(), include.includer.size()) ||
+                !file.read(include.requested.data(), include.requested.size()))
+                code.clear();
+            else
+                entryIncludes.push_back(std::move(include));
+        }
+    }
+    if (code.empty()) {
+        missCount++;
+        return code;
+    }
+
+    // validate include graph: every include is resolved again (search directories may have changed or a header
+    // earlier in search path may shadow it) and must resolve to the same file with the same content
+    for (const auto& include : entryIncludes) {
+        std::string resolvedName{};
+        std::string content{};
+        if (!resolver || !resolver->Resolve(include.requested, include.includer, include.relative, resolvedName, content) ||
+            resolvedName != include.name || Hasher().Add(content).value != include.contentHash) {
+            staleCount++;
+            missCount++;
+            return {};
+        }
+    }
+
+    // touch entry for LRU eviction
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), errorCode);
+    hitCount++;
+    if (includes) *includes = std::move(entryIncludes);
+    return code;
+}
+
+// store entry and evict old entries
+void SpirvCache::Store(uint64_t key, const std::vector<uint32_t>& code, const std::vector<ShaderInclude>& includes) {
+    // write temporary file (unique per thread and time) and rename it, so readers never see partial entries
+    const std::filesystem::path path = directory / (HashToString(key) + ".spv");
+    const uint64_t tempId = Hasher()
+        .AddValue(std::hash<std::thread::id>()(std::this_thread::get_id()))
+        .AddValue(std::chrono::steady_clock::now().time_since_epoch().count()).value;
+    const std::filesystem::path tempPath = directory / (HashToString(key) + "." + HashToString(tempId) + ".tmp");
+    SpirvCacheHeader header{};
+    header.key = key;
+    header.codeSize = code.size();
+    header.includeCount = includes.size();
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)code.data(), code.size() * sizeof(uint32_t));
+        for (const auto& include : includes) {
+            SpirvCacheInclude record{ (uint32_t)include.name.size(), (uint32_t)include.includer.size(), include.contentHash, (uint32_t)include.requested.size(), include.relative };
+            file.write((const char*)&record, sizeof(record));
+            file.write(include.name.data(), include.name.size());
+            file.write(include.includer.data(), include.includer.size());
+            file.write(include.requested.data(), include.requested.size());
+        }
+        if (!file) {
+            std::cout << "SPIR-V cache: can't write " << tempPath << std::endl;
+            return;
+        }
+    }
+    std::error_code errorCode{};
+    std::filesystem::rename(tempPath, path, errorCode);
+    if (errorCode) std::filesystem::remove(tempPath, errorCode);
+    Evict();
+}
+
+// evict least recently used entries over size limit
+void SpirvCache::Evict() {
+    std::lock_guard<std::mutex> lock(evictMutex);
+    struct Entry {
+        std::filesystem::path path{};
+        std::filesystem::file_time_type time{};
+        uint64_t size{};
+    };
+    std::vector<Entry> entries{};
+    uint64_t totalSize{};
+    std::error_code errorCode{};
+    for (const auto& directoryEntry : std::filesystem::directory_iterator(directory, errorCode)) {
+        if (directoryEntry.path().extension() != ".spv") continue;
+        Entry entry{ directoryEntry.path(), directoryEntry.last_write_time(errorCode), directoryEntry.file_size(errorCode) };
+        if (errorCode) continue;
+        totalSize += entry.size;
+        entries.push_back(entry);
+    }
+    if (totalSize <= maxSize) return;
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.time < b.time; });
+    for (const auto& entry : entries) {
+        if (totalSize <= maxSize) break;
+        if (std::filesystem::remove(entry.path, errorCode)) totalSize -= entry.size;
+    }
+}
+
+// get compute shader SPIR-V from cache or compile it
+std::vector<uint32_t> GetComputeShaderSpirv(SpirvCache* cache, ShaderCompiler& compiler, std::string_view source, const char* name, const ShaderCompileOptions& options,
+    std::vector<ShaderInclude>* includes) {
+    // cache hit (includes unchanged): compiler is never touched
+    const uint64_t key = SpirvCache::ComputeKey(source, options);
+    if (cache) {
+        std::vector<uint32_t> code = cache->Load(key, options.includeResolver, includes);
+        if (!code.empty()) return code;
+    }
+
+    // cache miss or stale entry: compile and store with include graph
+    std::vector<ShaderInclude> compileIncludes{};
+    std::vector<uint32_t> code = CompileComputeShader(compiler.Get(), source, name, GetThreadCompileOptions(options), &compileIncludes);
+    if (cache && !code.empty()) cache->Store(key, code, compileIncludes);
+    if (includes) *includes = std::move(compileIncludes);
+    return code;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include "shader_compiler.hpp"
+
+// persistent content-addressed SPIR-V cache
+// entries are "<key>.spv" files, written atomically (temporary file + rename)
+// and evicted least recently used first when cache grows over size limit
+// entries record include graph with content hashes, entry is stale when any include changed
+class SpirvCache {
+public:
+    SpirvCache(const std::filesystem::path& directory, uint64_t maxSize);
+    // compute cache key from source, compile options and compiler version
+    static uint64_t ComputeKey(std::string_view source, const ShaderCompileOptions& options);
+    // load entry, includes are validated with resolver, returns empty code on miss or stale entry
+    std::vector<uint32_t> Load(uint64_t key, const ShaderIncludeResolver* resolver, std::vector<ShaderInclude>* includes = nullptr);
+    // store entry with its include graph and evict old entries
+    void Store(uint64_t key, const std::vector<uint32_t>& code, const std::vector<ShaderInclude>& includes);
+    // cache statistics
+    uint32_t GetHitCount() const { return hitCount.load(); }
+    uint32_t GetMissCount() const { return missCount.load(); }
+    uint32_t GetStaleCount() const { return staleCount.load(); }
+private:
+    void Evict();
+    std::filesystem::path directory{};
+    uint64_t maxSize{};
+    std::mutex evictMutex{};
+    std::atomic<uint32_t> hitCount{};
+    std::atomic<uint32_t> missCount{};
+    std::atomic<uint32_t> staleCount{};
+};
+
+// get compute shader SPIR-V from cache or compile it (compiler is not initialized on cache hit)
+// cache may be null to always compile, includes (optional) receives include graph
+std::vector<uint32_t> GetComputeShaderSpirv(SpirvCache* cache, ShaderCompiler& compiler, std::string_view source, const char* name, const ShaderCompileOptions& options,
+    std::vector<ShaderInclude>* includes = nullptr);
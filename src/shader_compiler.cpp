@@ -0,0 +1,191 @@
+#include "shader_compiler.hpp"
+#include "vulkan_loader.hpp"
+#include "hash.hpp"
+#include <filesystem>
+#include <iostream>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// get options key
+std::string ShaderCompileOptions::GetKey() const {
+    std::string key{};
+    for (const auto& [name, value] : macros)
+        key += "-D" + name + "=" + value + ";";
+    key += "-O" + std::to_string(optimizationLevel) + ";";
+    key += "-env" + std::to_string(targetEnvVersion) + ";";
+    key += "-spv" + std::to_string(spirvVersion) + ";";
+    if (generateDebugInfo) key += "-g;";
+    if (preserveBindings) key += "-preserve-bindings;";
+    return key;
+}
+
+// set target environment and SPIR-V version for device api version
+void ShaderCompileOptions::SetTargetApiVersion(uint32_t apiVersion) {
+    if (apiVersion >= VK_MAKE_API_VERSION(0, 1, 3, 0)) {
+        targetEnvVersion = shaderc_env_version_vulkan_1_3;
+        spirvVersion = shaderc_spirv_version_1_6;
+    } else if (apiVersion >= VK_MAKE_API_VERSION(0, 1, 2, 0)) {
+        targetEnvVersion = shaderc_env_version_vulkan_1_2;
+        spirvVersion = shaderc_spirv_version_1_5;
+    } else if (apiVersion >= VK_MAKE_API_VERSION(0, 1, 1, 0)) {
+        targetEnvVersion = shaderc_env_version_vulkan_1_1;
+        spirvVersion = shaderc_spirv_version_1_3;
+    } else {
+        targetEnvVersion = shaderc_env_version_vulkan_1_0;
+        spirvVersion = shaderc_spirv_version_1_0;
+    }
+}
+
+ShaderCompiler::~ShaderCompiler() {
+    if (compiler) shaderc_compiler_release(compiler);
+}
+
+// get shaderc compiler
+shaderc_compiler_t ShaderCompiler::Get() {
+    std::call_once(initializeFlag, [this]() { compiler = shaderc_compiler_initialize(); });
+    return compiler;
+}
+
+// create shaderc compile options
+shaderc_compile_options_t CreateShadercCompileOptions(const ShaderCompileOptions& options) {
+    shaderc_compile_options_t compileOptions = shaderc_compile_options_initialize();
+    for (const auto& [name, value] : options.macros)
+        shaderc_compile_options_add_macro_definition(compileOptions, name.data(), name.size(), value.data(), value.size());
+    shaderc_compile_options_set_optimization_level(compileOptions, options.optimizationLevel);
+    shaderc_compile_options_set_target_env(compileOptions, shaderc_target_env_vulkan, options.targetEnvVersion);
+    shaderc_compile_options_set_target_spirv(compileOptions, options.spirvVersion);
+    if (options.generateDebugInfo) shaderc_compile_options_set_generate_debug_info(compileOptions);
+    shaderc_compile_options_set_preserve_bindings(compileOptions, options.preserveBindings);
+    return compileOptions;
+}
+
+// calling thread's include resolver and include graph of current compilation
+struct ThreadIncludeRecord {
+    const ShaderIncludeResolver* resolver{};
+    std::vector<ShaderInclude> includes{};
+};
+static thread_local ThreadIncludeRecord threadIncludeRecord{};
+
+// include result with owned strings
+struct IncludeResult {
+    shaderc_include_result result{};
+    std::string name{};
+    std::string content{};
+};
+
+// shaderc include resolve callback: resolve and record include graph edge
+static shaderc_include_result* ResolveInclude(void* userData, const char* requestedSource, int type, const char* requestingSource, size_t) {
+    ThreadIncludeRecord* record = (ThreadIncludeRecord*)userData;
+    IncludeResult* includeResult = new IncludeResult();
+    if (record->resolver && record->resolver->Resolve(requestedSource, requestingSource, type == shaderc_include_type_relative, includeResult->name, includeResult->content))
+        record->includes.push_back({ includeResult->name, requestingSource, Hasher().Add(includeResult->content).value, requestedSource, type == shaderc_include_type_relative });
+    else {
+        // empty name reports error, content is error message
+        includeResult->name.clear();
+        includeResult->content = std::string("can't resolve include ") + requestedSource;
+    }
+    includeResult->result.source_name = includeResult->name.data();
+    includeResult->result.source_name_length = includeResult->name.size();
+    includeResult->result.content = includeResult->content.data();
+    includeResult->result.content_length = includeResult->content.size();
+    includeResult->result.user_data = includeResult;
+    return &includeResult->result;
+}
+
+// shaderc include release callback
+static void ReleaseInclude(void*, shaderc_include_result* result) {
+    delete (IncludeResult*)result->user_data;
+}
+
+// get calling thread's shaderc compile options
+shaderc_compile_options_t GetThreadCompileOptions(const ShaderCompileOptions& options) {
+    struct ThreadCompileOptions {
+        std::string key{};
+        shaderc_compile_options_t options{};
+        ~ThreadCompileOptions() { if (options) shaderc_compile_options_release(options); }
+    };
+    thread_local ThreadCompileOptions threadCompileOptions{};
+    std::string key = options.GetKey();
+    if (!threadCompileOptions.options || threadCompileOptions.key != key) {
+        if (threadCompileOptions.options) shaderc_compile_options_release(threadCompileOptions.options);
+        threadCompileOptions.options = CreateShadercCompileOptions(options);
+        threadCompileOptions.key = std::move(key);
+        shaderc_compile_options_set_include_callbacks(threadCompileOptions.options, ResolveInclude, ReleaseInclude, &threadIncludeRecord);
+    }
+    threadIncludeRecord.resolver = options.includeResolver;
+    return threadCompileOptions.options;
+}
+
+// compile compute shader
+std::vector<uint32_t> CompileComputeShader(shaderc_compiler_t compiler, std::string_view source, const char* name, shaderc_compile_options_t options,
+    std::vector<ShaderInclude>* includes) {
+    threadIncludeRecord.includes.clear();
+    shaderc_compilation_result_t result = shaderc_compile_into_spv(compiler, source.data(), source.size(), shaderc_glsl_default_compute_shader, name, "main", options);
+    std::vector<uint32_t> code{};
+    if (shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success) {
+        const uint32_t* bytes = (const uint32_t*)shaderc_result_get_bytes(result);
+        code.assign(bytes, bytes + shaderc_result_get_length(result) / sizeof(uint32_t));
+    } else
+        std::cout << "Shader compiler: " << shaderc_result_get_error_message(result) << std::endl;
+    shaderc_result_release(result);
+    if (includes) *includes = std::move(threadIncludeRecord.includes);
+    return code;
+}
+
+// get optimization level name
+const char* GetOptimizationLevelName(shaderc_optimization_level optimizationLevel) {
+    switch (optimizationLevel) {
+    case shaderc_optimization_level_zero:        return "zero";
+    case shaderc_optimization_level_size:        return "size";
+    case shaderc_optimization_level_performance: return "performance";
+    }
+    return "unknown";
+}
+
+// parse optimization level name
+shaderc_optimization_level ParseOptimizationLevel(const std::string& name) {
+    if (name == "zero") return shaderc_optimization_level_zero;
+    if (name == "size") return shaderc_optimization_level_size;
+    if (!name.empty() && name != "performance") std::cout << "Unknown shader optimization level " << name << ", using performance" << std::endl;
+    return shaderc_optimization_level_performance;
+}
+
+// get path of module (shared library or executable) containing shaderc
+static std::string GetShadercModulePath() {
+#ifdef _WIN32
+    HMODULE module{};
+    if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)(void*)&shaderc_compiler_initialize, &module))
+        return {};
+    char path[MAX_PATH]{};
+    const DWORD size = GetModuleFileNameA(module, path, MAX_PATH);
+    return size && size < MAX_PATH ? std::string(path, size) : std::string{};
+#else
+    Dl_info info{};
+    if (!dladdr((void*)&shaderc_compiler_initialize, &info) || !info.dli_fname) return {};
+    return info.dli_fname;
+#endif
+}
+
+// get shaderc version string: shaderc has no version query (shaderc_get_spv_version is the SPIR-V version it emits,
+// same across compiler releases), so build is identified by path, size and modification time of the module containing shaderc
+// (metadata only, the module is not read)
+std::string GetShadercVersion() {
+    unsigned int version{}, revision{};
+    shaderc_get_spv_version(&version, &revision);
+    std::string shadercVersion = std::to_string(version) + "." + std::to_string(revision);
+
+    const std::string path = GetShadercModulePath();
+    std::error_code sizeErrorCode{}, timeErrorCode{};
+    const uintmax_t size = path.empty() ? 0 : std::filesystem::file_size(path, sizeErrorCode);
+    const auto writeTime = path.empty() ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(path, timeErrorCode);
+    if (path.empty() || sizeErrorCode || timeErrorCode) {
+        std::cout << "Can't identify shaderc build, SPIR-V cache keys use SPIR-V version only" << std::endl;
+        return shadercVersion;
+    }
+    Hasher hasher{};
+    hasher.Add(path).AddValue((uint64_t)size).AddValue((int64_t)writeTime.time_since_epoch().count());
+    return shadercVersion + "-" + HashToString(hasher.value);
+}
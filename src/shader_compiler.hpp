@@ -0,0 +1,61 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <vector>
+#include <utility>
+#include <string_view>
+#include <shaderc/shaderc.h>
+#include "shader_include.hpp"
+
+// shader compile options
+struct ShaderCompileOptions {
+    std::vector<std::pair<std::string, std::string>> macros{};
+    shaderc_optimization_level optimizationLevel = shaderc_optimization_level_performance;
+    shaderc_env_version targetEnvVersion = shaderc_env_version_vulkan_1_3;
+    shaderc_spirv_version spirvVersion = shaderc_spirv_version_1_6;
+    bool generateDebugInfo{};
+    bool preserveBindings = true;                   // keep declared bindings the optimizer would strip, reflected layouts match declared interface
+    const ShaderIncludeResolver* includeResolver{}; // #include resolution (null fails every include), not part of key
+    // set target environment and SPIR-V version for device api version
+    void SetTargetApiVersion(uint32_t apiVersion);
+    // get options key (part of shader cache key)
+    std::string GetKey() const;
+};
+
+// shader compiler, shaderc compiler is initialized on first compilation only
+class ShaderCompiler {
+public:
+    ShaderCompiler() = default;
+    ~ShaderCompiler();
+    ShaderCompiler(const ShaderCompiler&) = delete;
+    ShaderCompiler& operator=(const ShaderCompiler&) = delete;
+    // get shaderc compiler (initialized on first call, thread safe)
+    shaderc_compiler_t Get();
+    // check compiler was initialized
+    bool IsInitialized() const { return compiler != nullptr; }
+private:
+    std::once_flag initializeFlag{};
+    shaderc_compiler_t compiler{};
+};
+
+// create shaderc compile options
+shaderc_compile_options_t CreateShadercCompileOptions(const ShaderCompileOptions& options);
+
+// get calling thread's shaderc compile options (shaderc_compile_options_t is not thread safe),
+// options object is reused by thread while options do not change and released on thread exit
+// includes are resolved by options include resolver and recorded per thread
+shaderc_compile_options_t GetThreadCompileOptions(const ShaderCompileOptions& options);
+
+// compile compute shader, returns empty code on failure
+// includes (optional) receives include graph, when options come from GetThreadCompileOptions on calling thread
+std::vector<uint32_t> CompileComputeShader(shaderc_compiler_t compiler, std::string_view source, const char* name, shaderc_compile_options_t options,
+    std::vector<ShaderInclude>* includes = nullptr);
+
+// get optimization level name
+const char* GetOptimizationLevelName(shaderc_optimization_level optimizationLevel);
+
+// parse optimization level name ("zero", "size" or "performance"), returns performance for unknown names
+shaderc_optimization_level ParseOptimizationLevel(const std::string& name);
+
+// get shaderc version string (SPIR-V version and revision, identity of shaderc library file), used in cache keys
+std::string GetShadercVersion();
@@ -0,0 +1,66 @@
+#include "shader_include.hpp"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// embedded shader headers (generated by build/mingw/Makefile)
+struct EmbeddedShaderHeader {
+    const char* name{};
+    const char* content{};
+};
+static const EmbeddedShaderHeader embeddedShaderHeaders[] = {
+#define EMBEDDED_HEADER(name, content) { name, content },
+#include "embedded_headers.inc"
+#undef EMBEDDED_HEADER
+    { nullptr, nullptr }
+};
+
+// embedded header name prefix of resolved names
+static const std::string embeddedPrefix = "embedded:";
+
+// read file text
+static bool ReadTextFile(const std::filesystem::path& path, std::string& content) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream text{};
+    text << file.rdbuf();
+    content = text.str();
+    return true;
+}
+
+// get embedded header content
+const char* FindEmbeddedShaderHeader(const std::string& name) {
+    for (const auto& header : embeddedShaderHeaders)
+        if (header.name && name == header.name) return header.content;
+    return nullptr;
+}
+
+ShaderIncludeResolver::ShaderIncludeResolver(std::vector<std::filesystem::path> directories) : directories(std::move(directories)) {}
+
+// resolve include
+bool ShaderIncludeResolver::Resolve(const std::string& requested, const std::string& requesting, bool relative, std::string& resolvedName, std::string& content) const {
+    // directory of including file (embedded headers and top level shaders have none)
+    std::vector<std::filesystem::path> searchDirectories{};
+    if (relative && requesting.compare(0, embeddedPrefix.size(), embeddedPrefix) != 0) {
+        std::filesystem::path requestingPath(requesting);
+        if (requestingPath.has_parent_path()) searchDirectories.push_back(requestingPath.parent_path());
+    }
+    searchDirectories.insert(searchDirectories.end(), directories.begin(), directories.end());
+
+    // kernel library files
+    for (const auto& directory : searchDirectories) {
+        const std::filesystem::path path = (directory / requested).lexically_normal();
+        if (ReadTextFile(path, content)) {
+            resolvedName = path.generic_string();
+            return true;
+        }
+    }
+
+    // embedded headers
+    if (const char* embedded = FindEmbeddedShaderHeader(requested)) {
+        resolvedName = embeddedPrefix + requested;
+        content = embedded;
+        return true;
+    }
+    return false;
+}
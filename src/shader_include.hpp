@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+// resolved include (edge of include graph)
+struct ShaderInclude {
+    std::string name{};     // resolved name: file path or "embedded:<name>"
+    std::string includer{}; // resolved name of including file (shader name for top level includes)
+    uint64_t contentHash{};
+    std::string requested{}; // name in #include directive (resolved again on validation)
+    bool relative{};         // "file" include (angle bracket include otherwise)
+};
+
+// shader include resolver: kernel library directories first, then headers embedded at build time (shaders/include/*.glsl)
+// "file" includes are also searched next to including file
+class ShaderIncludeResolver {
+public:
+    explicit ShaderIncludeResolver(std::vector<std::filesystem::path> directories);
+    // resolve include, returns false if include is not found
+    bool Resolve(const std::string& requested, const std::string& requesting, bool relative, std::string& resolvedName, std::string& content) const;
+    // get library directories
+    const std::vector<std::filesystem::path>& GetDirectories() const { return directories; }
+private:
+    std::vector<std::filesystem::path> directories{};
+};
+
+// get embedded header content, returns null if header is not embedded
+const char* FindEmbeddedShaderHeader(const std::string& name);
@@ -0,0 +1,75 @@
+#include "specialization.hpp"
+#include <cstring>
+#include <algorithm>
+
+// set constant value
+SpecConstants& SpecConstants::Set(uint32_t specId, uint64_t value) {
+    auto position = std::lower_bound(values.begin(), values.end(), specId, [](const auto& entry, uint32_t id) { return entry.first < id; });
+    if (position != values.end() && position->first == specId) position->second = value;
+    else values.insert(position, { specId, value });
+    return *this;
+}
+
+// set workgroup size through local_size_*_id constants
+SpecConstants& SpecConstants::SetLocalSize(const SpirvReflection& reflection, uint32_t x, uint32_t y, uint32_t z) {
+    const uint32_t localSize[3]{ x, y, z };
+    for (uint32_t i = 0; i < 3; i++)
+        if (reflection.localSizeSpecIds[i] != UINT32_MAX) Set(reflection.localSizeSpecIds[i], localSize[i]);
+    return *this;
+}
+
+// get constant value
+uint64_t SpecConstants::Get(uint32_t specId, uint64_t defaultValue) const {
+    for (const auto& [id, value] : values)
+        if (id == specId) return value;
+    return defaultValue;
+}
+
+// get key
+std::string SpecConstants::GetKey() const {
+    std::string key{};
+    for (const auto& [id, value] : values)
+        key += std::to_string(id) + "=" + std::to_string(value) + ";";
+    return key;
+}
+
+// build specialization info
+void BuildSpecializationInfo(const SpirvReflection& reflection, const SpecConstants& constants, SpecializationInfo& specializationInfo) {
+    specializationInfo.mapEntries.clear();
+    specializationInfo.data.clear();
+    for (const auto& [id, value] : constants.values) {
+        const SpirvSpecConstant* specConstant = reflection.FindSpecConstant(id);
+        if (!specConstant) continue;
+        // constants are little endian, 4 or 8 bytes
+        const uint32_t size = std::min<uint32_t>(specConstant->size, sizeof(uint64_t));
+        specializationInfo.mapEntries.push_back({ id, (uint32_t)specializationInfo.data.size(), size });
+        const size_t offset = specializationInfo.data.size();
+        specializationInfo.data.resize(offset + size);
+        memcpy(specializationInfo.data.data() + offset, &value, size);
+    }
+    specializationInfo.info.mapEntryCount = (uint32_t)specializationInfo.mapEntries.size();
+    specializationInfo.info.pMapEntries = specializationInfo.mapEntries.data();
+    specializationInfo.info.dataSize = specializationInfo.data.size();
+    specializationInfo.info.pData = specializationInfo.data.data();
+}
+
+// get workgroup size of specialized kernel
+void GetSpecializedLocalSize(const SpirvReflection& reflection, const SpecConstants& constants, uint32_t localSize[3]) {
+    for (uint32_t i = 0; i < 3; i++)
+        localSize[i] = reflection.localSizeSpecIds[i] == UINT32_MAX ? reflection.localSize[i] : (uint32_t)constants.Get(reflection.localSizeSpecIds[i], reflection.localSize[i]);
+}
+
+SpecializedKernel::SpecializedKernel(PipelineRegistry& registry, uint64_t moduleHash, const KernelLayout& layout, const SpirvReflection& reflection) :
+    registry(registry), moduleHash(moduleHash), layout(layout), reflection(reflection) {}
+
+// request pipeline specialized with constants
+PipelineFuture SpecializedKernel::RequestPipeline(const SpecConstants& constants, PipelinePriority priority) {
+    SpecializationInfo specializationInfo{};
+    BuildSpecializationInfo(reflection, constants, specializationInfo);
+    return registry.Request(moduleHash, layout, specializationInfo.Get(), priority);
+}
+
+// get pipeline specialized with constants
+KernelProgram SpecializedKernel::GetPipeline(const SpecConstants& constants) {
+    return registry.Get(RequestPipeline(constants, PipelinePriority::Dispatch));
+}
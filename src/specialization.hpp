@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "vulkan_loader.hpp"
+#include "pipeline_registry.hpp"
+#include "spirv_reflection.hpp"
+
+// specialization constant values (constant_id -> value)
+struct SpecConstants {
+    std::vector<std::pair<uint32_t, uint64_t>> values{}; // sorted by constant id
+    // set constant value
+    SpecConstants& Set(uint32_t specId, uint64_t value);
+    // set workgroup size through local_size_*_id constants of kernel, fixed dimensions are ignored
+    SpecConstants& SetLocalSize(const SpirvReflection& reflection, uint32_t x, uint32_t y, uint32_t z = 1);
+    // get constant value, returns default value if constant is not set
+    uint64_t Get(uint32_t specId, uint64_t defaultValue) const;
+    // get key (part of pipeline keys)
+    std::string GetKey() const;
+};
+
+// specialization info of module: constants not used by module are dropped, constant sizes come from reflection
+struct SpecializationInfo {
+    std::vector<VkSpecializationMapEntry> mapEntries{};
+    std::vector<uint8_t> data{};
+    VkSpecializationInfo info{};
+    // get specialization info, null when no constant is specialized
+    const VkSpecializationInfo* Get() const { return mapEntries.empty() ? VK_NULL_HANDLE : &info; }
+};
+
+// build specialization info (info points into mapEntries and data, rebuilt on every call)
+void BuildSpecializationInfo(const SpirvReflection& reflection, const SpecConstants& constants, SpecializationInfo& specializationInfo);
+
+// get workgroup size of specialized kernel
+void GetSpecializedLocalSize(const SpirvReflection& reflection, const SpecConstants& constants, uint32_t localSize[3]);
+
+// specialized pipelines of one kernel module: pipelines are requested from registry per constant values,
+// constants not used by module map to the same pipeline
+class SpecializedKernel {
+public:
+    SpecializedKernel(PipelineRegistry& registry, uint64_t moduleHash, const KernelLayout& layout, const SpirvReflection& reflection);
+    // request pipeline specialized with constants, returns immediately
+    PipelineFuture RequestPipeline(const SpecConstants& constants, PipelinePriority priority = PipelinePriority::Background);
+    // get pipeline specialized with constants (requested with dispatch priority and waited for), returns null on failure
+    KernelProgram GetPipeline(const SpecConstants& constants);
+    // get pipeline of request
+    KernelProgram GetPipeline(const PipelineFuture& future) { return registry.Get(future); }
+    // get kernel reflection (default constant values)
+    const SpirvReflection& GetReflection() const { return reflection; }
+private:
+    PipelineRegistry& registry;
+    uint64_t moduleHash{};
+    KernelLayout layout{};
+    SpirvReflection reflection{};
+};
@@ -0,0 +1,389 @@
+#include "spirv_reflection.hpp"
+#include <map>
+#include <iostream>
+#include <algorithm>
+
+// SPIR-V enumerants used by reflection
+enum : uint32_t {
+    SpvMagicNumber = 0x07230203,
+    // opcodes
+    SpvOpName = 5,
+    SpvOpMemberName = 6,
+    SpvOpExecutionMode = 16,
+    SpvOpTypeBool = 20,
+    SpvOpTypeInt = 21,
+    SpvOpTypeFloat = 22,
+    SpvOpTypeVector = 23,
+    SpvOpTypeMatrix = 24,
+    SpvOpTypeImage = 25,
+    SpvOpTypeSampler = 26,
+    SpvOpTypeSampledImage = 27,
+    SpvOpTypeArray = 28,
+    SpvOpTypeRuntimeArray = 29,
+    SpvOpTypeStruct = 30,
+    SpvOpTypePointer = 32,
+    SpvOpConstant = 43,
+    SpvOpConstantComposite = 44,
+    SpvOpSpecConstantTrue = 48,
+    SpvOpSpecConstantFalse = 49,
+    SpvOpSpecConstant = 50,
+    SpvOpSpecConstantComposite = 51,
+    SpvOpVariable = 59,
+    SpvOpDecorate = 71,
+    SpvOpMemberDecorate = 72,
+    SpvOpExecutionModeId = 331,
+    SpvOpTypeAccelerationStructureKHR = 5341,
+    // decorations
+    SpvDecorationSpecId = 1,
+    SpvDecorationBlock = 2,
+    SpvDecorationBufferBlock = 3,
+    SpvDecorationArrayStride = 6,
+    SpvDecorationMatrixStride = 7,
+    SpvDecorationBuiltIn = 11,
+    SpvDecorationBinding = 33,
+    SpvDecorationDescriptorSet = 34,
+    SpvDecorationOffset = 35,
+    SpvBuiltInWorkgroupSize = 25,
+    // storage classes
+    SpvStorageClassUniformConstant = 0,
+    SpvStorageClassUniform = 2,
+    SpvStorageClassPushConstant = 9,
+    SpvStorageClassStorageBuffer = 12,
+    SpvStorageClassPhysicalStorageBuffer = 5349,
+    // execution modes
+    SpvExecutionModeLocalSize = 17,
+    SpvExecutionModeLocalSizeId = 38,
+    // image dimensions
+    SpvDimBuffer = 5,
+};
+
+// id decorations
+struct SpirvDecorations {
+    uint32_t set = UINT32_MAX;
+    uint32_t binding = UINT32_MAX;
+    uint32_t specId = UINT32_MAX;
+    uint32_t arrayStride{};
+    uint32_t builtIn = UINT32_MAX;
+    bool block{};
+    bool bufferBlock{};
+};
+
+// parsed module: instructions of ids and their decorations
+struct SpirvModule {
+    std::map<uint32_t, std::vector<uint32_t>> definitions{};  // result id -> instruction words (types, constants, variables)
+    std::map<uint32_t, SpirvDecorations> decorations{};
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> memberOffsets{};
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> memberMatrixStrides{};
+    std::map<uint32_t, std::string> names{};
+    std::map<std::pair<uint32_t, uint32_t>, std::string> memberNames{};
+    std::vector<uint32_t> variables{};
+};
+
+// decode literal string operand
+static std::string DecodeString(const uint32_t* words, size_t wordCount) {
+    std::string text{};
+    for (size_t i = 0; i < wordCount; i++)
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            const char c = (char)((words[i] >> shift) & 0xff);
+            if (c == 0) return text;
+            text += c;
+        }
+    return text;
+}
+
+// get 32-bit constant value (constants and default value of specialization constants)
+static bool GetConstantValue(const SpirvModule& module, uint32_t id, uint32_t& value) {
+    auto definition = module.definitions.find(id);
+    if (definition == module.definitions.end()) return false;
+    const std::vector<uint32_t>& words = definition->second;
+    const uint32_t opcode = words[0] & 0xffff;
+    if ((opcode == SpvOpConstant || opcode == SpvOpSpecConstant) && words.size() > 3) value = words[3];
+    else if (opcode == SpvOpSpecConstantTrue) value = 1;
+    else if (opcode == SpvOpSpecConstantFalse) value = 0;
+    else return false;
+    return true;
+}
+
+// get specialization id of constant, UINT32_MAX for constants that are not specializable
+static uint32_t GetSpecId(const SpirvModule& module, uint32_t id) {
+    auto decorations = module.decorations.find(id);
+    return decorations == module.decorations.end() ? UINT32_MAX : decorations->second.specId;
+}
+
+// get type size in bytes (explicit layout: offsets, array and matrix strides)
+static uint32_t GetTypeSize(const SpirvModule& module, uint32_t typeId, uint32_t matrixStride = 0) {
+    auto definition = module.definitions.find(typeId);
+    if (definition == module.definitions.end()) return 0;
+    const std::vector<uint32_t>& words = definition->second;
+    switch (words[0] & 0xffff) {
+    case SpvOpTypeBool:   return 4;
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:  return words[2] / 8;
+    case SpvOpTypeVector: return GetTypeSize(module, words[2]) * words[3];
+    case SpvOpTypeMatrix: return matrixStride ? matrixStride * words[3] : GetTypeSize(module, words[2]) * words[3];
+    case SpvOpTypePointer: return 8; // physical storage buffer pointers
+    case SpvOpTypeArray: {
+        uint32_t length{};
+        if (!GetConstantValue(module, words[3], length)) return 0;
+        auto decorations = module.decorations.find(typeId);
+        const uint32_t arrayStride = decorations == module.decorations.end() ? 0 : decorations->second.arrayStride;
+        return length * (arrayStride ? arrayStride : GetTypeSize(module, words[2], matrixStride));
+    }
+    case SpvOpTypeStruct: {
+        uint32_t size{};
+        for (uint32_t member = 0; member + 2 < words.size(); member++) {
+            auto offset = module.memberOffsets.find({ typeId, member });
+            auto memberMatrixStride = module.memberMatrixStrides.find({ typeId, member });
+            const uint32_t memberSize = GetTypeSize(module, words[2 + member], memberMatrixStride == module.memberMatrixStrides.end() ? 0 : memberMatrixStride->second);
+            size = std::max(size, (offset == module.memberOffsets.end() ? size : offset->second) + memberSize);
+        }
+        return size;
+    }
+    }
+    return 0;
+}
+
+// get members of push constant block type (kernel argument ABI)
+static std::vector<SpirvPushConstantMember> GetPushConstantMembers(const SpirvModule& module, uint32_t typeId) {
+    std::vector<SpirvPushConstantMember> members{};
+    auto definition = module.definitions.find(typeId);
+    if (definition == module.definitions.end() || (definition->second[0] & 0xffff) != SpvOpTypeStruct) return members;
+    const std::vector<uint32_t>& words = definition->second;
+    for (uint32_t member = 0; member + 2 < words.size(); member++) {
+        SpirvPushConstantMember pushConstantMember{};
+        auto offset = module.memberOffsets.find({ typeId, member });
+        auto matrixStride = module.memberMatrixStrides.find({ typeId, member });
+        pushConstantMember.offset = offset == module.memberOffsets.end() ? 0 : offset->second;
+        pushConstantMember.size = GetTypeSize(module, words[2 + member], matrixStride == module.memberMatrixStrides.end() ? 0 : matrixStride->second);
+        auto memberType = module.definitions.find(words[2 + member]);
+        pushConstantMember.pointer = memberType != module.definitions.end() && (memberType->second[0] & 0xffff) == SpvOpTypePointer &&
+            memberType->second.size() > 2 && memberType->second[2] == SpvStorageClassPhysicalStorageBuffer;
+        auto name = module.memberNames.find({ typeId, member });
+        if (name != module.memberNames.end()) pushConstantMember.name = name->second;
+        members.push_back(pushConstantMember);
+    }
+    std::sort(members.begin(), members.end(), [](const auto& a, const auto& b) { return a.offset < b.offset; });
+    return members;
+}
+
+// get descriptor type of resource type in storage class, returns false if type is not a descriptor
+static bool GetDescriptorType(const SpirvModule& module, uint32_t typeId, uint32_t storageClass, VkDescriptorType& descriptorType) {
+    auto definition = module.definitions.find(typeId);
+    if (definition == module.definitions.end()) return false;
+    const std::vector<uint32_t>& words = definition->second;
+    auto decorations = module.decorations.find(typeId);
+    switch (words[0] & 0xffff) {
+    case SpvOpTypeSampler:
+        descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+        return true;
+    case SpvOpTypeSampledImage: {
+        auto image = module.definitions.find(words[2]);
+        const bool buffer = image != module.definitions.end() && image->second.size() > 3 && image->second[3] == SpvDimBuffer;
+        descriptorType = buffer ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        return true;
+    }
+    case SpvOpTypeImage: {
+        if (words.size() < 8) return false;
+        const bool buffer = words[3] == SpvDimBuffer;
+        const bool storage = words[7] == 2;
+        if (buffer) descriptorType = storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+        else descriptorType = storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        return true;
+    }
+    case SpvOpTypeAccelerationStructureKHR:
+        descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        return true;
+    case SpvOpTypeStruct:
+        if (storageClass == SpvStorageClassStorageBuffer || (decorations != module.decorations.end() && decorations->second.bufferBlock))
+            descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        else if (storageClass == SpvStorageClassUniform)
+            descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        else
+            return false;
+        return true;
+    }
+    return false;
+}
+
+// find specialization constant
+const SpirvSpecConstant* SpirvReflection::FindSpecConstant(uint32_t specId) const {
+    for (const auto& specConstant : specConstants)
+        if (specConstant.specId == specId) return &specConstant;
+    return nullptr;
+}
+
+// reflect compute SPIR-V module
+bool ReflectSpirv(const uint32_t* code, size_t wordCount, SpirvReflection& reflection) {
+    reflection = SpirvReflection{};
+    if (!code || wordCount < 5 || code[0] != SpvMagicNumber) return false;
+
+    // collect definitions, decorations, names and execution modes
+    SpirvModule module{};
+    std::vector<uint32_t> localSizeIds{};
+    for (size_t offset = 5; offset < wordCount;) {
+        const uint32_t opcode = code[offset] & 0xffff;
+        const uint32_t length = code[offset] >> 16;
+        if (length == 0 || offset + length > wordCount) return false;
+        const uint32_t* words = code + offset;
+        switch (opcode) {
+        case SpvOpName:
+            if (length > 2) module.names[words[1]] = DecodeString(words + 2, length - 2);
+            break;
+        case SpvOpMemberName:
+            if (length > 3) module.memberNames[{ words[1], words[2] }] = DecodeString(words + 3, length - 3);
+            break;
+        case SpvOpExecutionMode:
+            if (length >= 6 && words[2] == SpvExecutionModeLocalSize)
+                for (uint32_t i = 0; i < 3; i++) reflection.localSize[i] = words[3 + i];
+            break;
+        case SpvOpExecutionModeId:
+            if (length >= 6 && words[2] == SpvExecutionModeLocalSizeId)
+                localSizeIds.assign(words + 3, words + 6);
+            break;
+        case SpvOpDecorate:
+            if (length >= 3) {
+                SpirvDecorations& decorations = module.decorations[words[1]];
+                const uint32_t operand = length > 3 ? words[3] : 0;
+                switch (words[2]) {
+                case SpvDecorationSpecId:        decorations.specId = operand; break;
+                case SpvDecorationBlock:         decorations.block = true; break;
+                case SpvDecorationBufferBlock:   decorations.bufferBlock = true; break;
+                case SpvDecorationArrayStride:   decorations.arrayStride = operand; break;
+                case SpvDecorationBuiltIn:       decorations.builtIn = operand; break;
+                case SpvDecorationBinding:       decorations.binding = operand; break;
+                case SpvDecorationDescriptorSet: decorations.set = operand; break;
+                }
+            }
+            break;
+        case SpvOpMemberDecorate:
+            if (length >= 5 && words[3] == SpvDecorationOffset) module.memberOffsets[{ words[1], words[2] }] = words[4];
+            if (length >= 5 && words[3] == SpvDecorationMatrixStride) module.memberMatrixStrides[{ words[1], words[2] }] = words[4];
+            break;
+        case SpvOpTypeBool: case SpvOpTypeInt: case SpvOpTypeFloat: case SpvOpTypeVector: case SpvOpTypeMatrix:
+        case SpvOpTypeImage: case SpvOpTypeSampler: case SpvOpTypeSampledImage: case SpvOpTypeArray:
+        case SpvOpTypeRuntimeArray: case SpvOpTypeStruct: case SpvOpTypePointer: case SpvOpTypeAccelerationStructureKHR:
+            if (length >= 2) module.definitions[words[1]].assign(words, words + length);
+            break;
+        case SpvOpConstant: case SpvOpConstantComposite: case SpvOpSpecConstantTrue: case SpvOpSpecConstantFalse:
+        case SpvOpSpecConstant: case SpvOpSpecConstantComposite: case SpvOpVariable:
+            if (length >= 3) module.definitions[words[2]].assign(words, words + length);
+            if (opcode == SpvOpVariable && length >= 4) module.variables.push_back(words[2]);
+            break;
+        }
+        offset += length;
+    }
+
+    // specialization constants
+    for (const auto& [id, words] : module.definitions) {
+        const uint32_t opcode = words[0] & 0xffff;
+        if (opcode != SpvOpSpecConstant && opcode != SpvOpSpecConstantTrue && opcode != SpvOpSpecConstantFalse) continue;
+        const uint32_t specId = GetSpecId(module, id);
+        if (specId == UINT32_MAX) continue;
+        SpirvSpecConstant specConstant{};
+        specConstant.specId = specId;
+        specConstant.size = std::max(4u, GetTypeSize(module, words[1]));
+        if (opcode == SpvOpSpecConstant) {
+            specConstant.defaultValue = words.size() > 3 ? words[3] : 0;
+            if (words.size() > 4) specConstant.defaultValue |= (uint64_t)words[4] << 32;
+        } else
+            specConstant.defaultValue = opcode == SpvOpSpecConstantTrue;
+        auto name = module.names.find(id);
+        if (name != module.names.end()) specConstant.name = name->second;
+        reflection.specConstants.push_back(specConstant);
+    }
+    std::sort(reflection.specConstants.begin(), reflection.specConstants.end(), [](const auto& a, const auto& b) { return a.specId < b.specId; });
+
+    // workgroup size: LocalSizeId operands or WorkgroupSize builtin override LocalSize
+    for (const auto& [id, decorations] : module.decorations) {
+        if (decorations.builtIn != SpvBuiltInWorkgroupSize) continue;
+        auto definition = module.definitions.find(id);
+        if (definition != module.definitions.end() && definition->second.size() >= 6)
+            localSizeIds.assign(definition->second.begin() + 3, definition->second.begin() + 6);
+    }
+    for (size_t i = 0; i < localSizeIds.size() && i < 3; i++) {
+        GetConstantValue(module, localSizeIds[i], reflection.localSize[i]);
+        reflection.localSizeSpecIds[i] = GetSpecId(module, localSizeIds[i]);
+    }
+
+    // resource variables
+    for (uint32_t variable : module.variables) {
+        const std::vector<uint32_t>& words = module.definitions[variable];
+        const uint32_t storageClass = words[3];
+        auto pointer = module.definitions.find(words[1]);
+        if (pointer == module.definitions.end() || pointer->second.size() < 4) continue;
+        uint32_t typeId = pointer->second[3];
+
+        // push constant block
+        if (storageClass == SpvStorageClassPushConstant) {
+            reflection.pushConstantSize = std::max(reflection.pushConstantSize, GetTypeSize(module, typeId));
+            reflection.pushConstantMembers = GetPushConstantMembers(module, typeId);
+            continue;
+        }
+        if (storageClass != SpvStorageClassUniformConstant && storageClass != SpvStorageClassUniform && storageClass != SpvStorageClassStorageBuffer) continue;
+
+        // descriptor arrays
+        SpirvDescriptorBinding binding{};
+        binding.descriptorCount = 1;
+        auto type = module.definitions.find(typeId);
+        while (type != module.definitions.end() && ((type->second[0] & 0xffff) == SpvOpTypeArray || (type->second[0] & 0xffff) == SpvOpTypeRuntimeArray)) {
+            uint32_t length{};
+            if ((type->second[0] & 0xffff) == SpvOpTypeRuntimeArray) binding.descriptorCount = 0;
+            else if (GetConstantValue(module, type->second[3], length)) binding.descriptorCount *= length;
+            typeId = type->second[2];
+            type = module.definitions.find(typeId);
+        }
+        if (!GetDescriptorType(module, typeId, storageClass, binding.descriptorType)) continue;
+
+        // set and binding (missing decorations mean set 0, binding 0)
+        auto decorations = module.decorations.find(variable);
+        if (decorations != module.decorations.end()) {
+            binding.set = decorations->second.set == UINT32_MAX ? 0 : decorations->second.set;
+            binding.binding = decorations->second.binding == UINT32_MAX ? 0 : decorations->second.binding;
+        }
+        auto name = module.names.find(variable);
+        if (name == module.names.end() || name->second.empty()) name = module.names.find(typeId);
+        if (name != module.names.end()) binding.name = name->second;
+        reflection.bindings.push_back(binding);
+    }
+    std::sort(reflection.bindings.begin(), reflection.bindings.end(), [](const auto& a, const auto& b) { return a.set != b.set ? a.set < b.set : a.binding < b.binding; });
+    return true;
+}
+
+// get descriptor type name
+const char* GetDescriptorTypeName(VkDescriptorType descriptorType) {
+    switch (descriptorType) {
+    case VK_DESCRIPTOR_TYPE_SAMPLER:                    return "sampler";
+    case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:     return "combined image sampler";
+    case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:              return "sampled image";
+    case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:              return "storage image";
+    case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:       return "uniform texel buffer";
+    case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:       return "storage texel buffer";
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:             return "uniform buffer";
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:             return "storage buffer";
+    case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR: return "acceleration structure";
+    default:                                            return "unknown";
+    }
+}
+
+// print reflection
+void PrintSpirvReflection(const char* name, const SpirvReflection& reflection) {
+    std::cout << "Kernel " << name << ": local size " << reflection.localSize[0] << "x" << reflection.localSize[1] << "x" << reflection.localSize[2];
+    std::cout << ", push constants " << reflection.pushConstantSize << " bytes" << std::endl;
+    for (const auto& member : reflection.pushConstantMembers) {
+        if (!member.pointer) continue;
+        std::cout << "  push constant offset " << member.offset << ": buffer reference";
+        if (!member.name.empty()) std::cout << " " << member.name;
+        std::cout << std::endl;
+    }
+    for (const auto& binding : reflection.bindings) {
+        std::cout << "  set " << binding.set << " binding " << binding.binding << ": " << GetDescriptorTypeName(binding.descriptorType);
+        if (binding.descriptorCount != 1) std::cout << "[" << (binding.descriptorCount ? std::to_string(binding.descriptorCount) : "") << "]";
+        if (!binding.name.empty()) std::cout << " " << binding.name;
+        std::cout << std::endl;
+    }
+    for (const auto& specConstant : reflection.specConstants) {
+        std::cout << "  constant_id " << specConstant.specId << ": " << specConstant.size << " bytes, default " << specConstant.defaultValue;
+        if (!specConstant.name.empty()) std::cout << " " << specConstant.name;
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "vulkan_loader.hpp"
+
+// reflected descriptor binding
+struct SpirvDescriptorBinding {
+    uint32_t set{};
+    uint32_t binding{};
+    VkDescriptorType descriptorType{};
+    uint32_t descriptorCount{};  // array size, zero for runtime sized arrays
+    std::string name{};          // variable name (block type name when variable is unnamed)
+};
+
+// reflected specialization constant
+struct SpirvSpecConstant {
+    uint32_t specId{};
+    uint32_t size{};             // in bytes (bool constants are 4 bytes)
+    uint64_t defaultValue{};
+    std::string name{};
+};
+
+// reflected member of push constant block
+struct SpirvPushConstantMember {
+    uint32_t offset{};
+    uint32_t size{};             // in bytes (physical storage buffer pointers are 8 bytes)
+    bool pointer{};              // buffer reference (GL_EXT_buffer_reference), host passes device address
+    std::string name{};
+};
+
+// SPIR-V module reflection (own parser, no SPIRV-Reflect dependency)
+struct SpirvReflection {
+    std::vector<SpirvDescriptorBinding> bindings{};     // sorted by set and binding
+    uint32_t pushConstantSize{};                         // in bytes, zero when kernel has no push constants
+    std::vector<SpirvPushConstantMember> pushConstantMembers{}; // sorted by offset
+    uint32_t localSize[3]{ 1, 1, 1 };                    // workgroup size (default values of specialization constants)
+    uint32_t localSizeSpecIds[3]{ UINT32_MAX, UINT32_MAX, UINT32_MAX }; // specialization constant ids of workgroup size, UINT32_MAX if fixed
+    std::vector<SpirvSpecConstant> specConstants{};     // sorted by id
+    // find specialization constant, returns null if id is not used
+    const SpirvSpecConstant* FindSpecConstant(uint32_t specId) const;
+};
+
+// reflect compute SPIR-V module, returns false if module is not valid SPIR-V
+bool ReflectSpirv(const uint32_t* code, size_t wordCount, SpirvReflection& reflection);
+
+// get descriptor type name
+const char* GetDescriptorTypeName(VkDescriptorType descriptorType);
+
+// print reflection
+void PrintSpirvReflection(const char* name, const SpirvReflection& reflection);
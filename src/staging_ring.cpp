@@ -0,0 +1,73 @@
+#include "staging_ring.hpp"
+#include <cstring>
+#include <algorithm>
+
+// align offset up
+static VkDeviceSize AlignUp(VkDeviceSize offset, VkDeviceSize alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+StagingRing::StagingRing(VkBuffer buffer, void* mappedData, VkDeviceSize size, VkDeviceSize alignment) :
+    buffer(buffer), mappedData((uint8_t*)mappedData), size(mappedData ? size : 0), alignment(std::max<VkDeviceSize>(4, alignment)) {}
+
+// allocate range at head, wrapping to ring start when range does not fit before ring end
+StagingAllocation StagingRing::Allocate(VkDeviceSize allocationSize, VkDeviceSize allocationAlignment) {
+    allocationAlignment = std::max(alignment, allocationAlignment);
+    if (!allocationSize || allocationSize > size) return {};
+    VkDeviceSize offset = AlignUp(head, allocationAlignment);
+    VkDeviceSize ringSize = offset - head + allocationSize;
+    if (offset + allocationSize > size) {
+        offset = 0;
+        ringSize = size - head + allocationSize;
+    }
+    // used bytes are one contiguous (wrapping) range ending at head, free bytes follow it
+    if (usedSize + ringSize > size) return {};
+    head = offset + allocationSize;
+    usedSize += ringSize;
+    unreleasedSize += ringSize;
+    allocationCount++;
+    allocatedBytes += allocationSize;
+    return { buffer, offset, allocationSize, mappedData + offset };
+}
+
+// allocate range and copy data into it
+StagingAllocation StagingRing::Upload(const void* data, VkDeviceSize uploadSize, VkDeviceSize uploadAlignment) {
+    StagingAllocation allocation = Allocate(uploadSize, uploadAlignment);
+    if (allocation) memcpy(allocation.data, data, uploadSize);
+    return allocation;
+}
+
+// release ranges allocated since previous release
+void StagingRing::Release(uint64_t value) {
+    if (!unreleasedSize) return;
+    pendingRanges.push_back({ unreleasedSize, value });
+    unreleasedSize = 0;
+}
+
+// reuse ranges of completed jobs (jobs complete in release order)
+void StagingRing::Reclaim(uint64_t completedValue) {
+    while (!pendingRanges.empty() && pendingRanges.front().value <= completedValue) {
+        usedSize -= pendingRanges.front().size;
+        pendingRanges.pop_front();
+    }
+    // empty ring restarts at offset 0, large uploads do not wrap
+    if (!usedSize) head = 0;
+}
+
+// record copy of staging range to buffer
+void RecordStagingCopy(VkCommandBuffer commandBuffer, const StagingAllocation& allocation, VkBuffer buffer, VkDeviceSize offset) {
+    const VkBufferCopy bufferCopy{ allocation.offset, offset, allocation.size };
+    vkCmdCopyBuffer(commandBuffer, allocation.buffer, buffer, 1, &bufferCopy);
+}
+
+// record copy of staging range to color image
+void RecordStagingCopy(VkCommandBuffer commandBuffer, const StagingAllocation& allocation, VkImage image, VkImageLayout imageLayout, VkExtent3D extent) {
+    VkBufferImageCopy bufferImageCopy{};
+    bufferImageCopy.bufferOffset = allocation.offset;
+    bufferImageCopy.bufferRowLength = 0;
+    bufferImageCopy.bufferImageHeight = 0;
+    bufferImageCopy.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    bufferImageCopy.imageOffset = { 0, 0, 0 };
+    bufferImageCopy.imageExtent = extent;
+    vkCmdCopyBufferToImage(commandBuffer, allocation.buffer, image, imageLayout, 1, &bufferImageCopy);
+}
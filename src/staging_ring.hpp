@@ -0,0 +1,60 @@
+#pragma once
+#include <deque>
+#include <cstdint>
+#include "vulkan_loader.hpp"
+
+// staging suballocation: buffer range and host pointer into its persistent mapping
+struct StagingAllocation {
+    VkBuffer buffer{};
+    VkDeviceSize offset{};
+    VkDeviceSize size{};
+    uint8_t* data{};
+    // check range was allocated
+    explicit operator bool() const { return data != nullptr; }
+};
+
+// staging ring of uploads: one persistently mapped host visible buffer, suballocated linearly and wrapping around,
+// suballocations of a job are released together against its value (AsyncComputeExecutor job value, fence or timeline)
+// and reused once that value completed, so uploads need no allocation and no map/unmap (used by one recording thread)
+class StagingRing {
+public:
+    // buffer: transfer source, host visible and coherent (sequential write access), persistently mapped by caller
+    StagingRing(VkBuffer buffer, void* mappedData, VkDeviceSize size, VkDeviceSize alignment = 16);
+    StagingRing(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+    // allocate range, null data when ring has no room until pending jobs complete
+    StagingAllocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+    // allocate range and copy data into it
+    StagingAllocation Upload(const void* data, VkDeviceSize size, VkDeviceSize alignment = 0);
+    // release ranges allocated since previous release, they are reused after job of value completed
+    void Release(uint64_t value);
+    // reuse ranges of jobs up to completed value
+    void Reclaim(uint64_t completedValue);
+    // get allocated bytes (pending and unreleased ranges) and ring size
+    VkDeviceSize GetUsedSize() const { return usedSize; }
+    VkDeviceSize GetSize() const { return size; }
+    // get count and bytes of allocations
+    uint64_t GetAllocationCount() const { return allocationCount; }
+    uint64_t GetAllocatedBytes() const { return allocatedBytes; }
+private:
+    struct PendingRange {
+        VkDeviceSize size{};  // ring bytes of job, alignment padding and wrapped end included
+        uint64_t value{};
+    };
+    VkBuffer buffer{};
+    uint8_t* mappedData{};
+    VkDeviceSize size{};
+    VkDeviceSize alignment{};
+    VkDeviceSize head{};              // next allocation offset, used bytes end here
+    VkDeviceSize usedSize{};
+    VkDeviceSize unreleasedSize{};    // ring bytes allocated since previous release
+    std::deque<PendingRange> pendingRanges{};
+    uint64_t allocationCount{};
+    uint64_t allocatedBytes{};
+};
+
+// record copy of staging range to buffer
+void RecordStagingCopy(VkCommandBuffer commandBuffer, const StagingAllocation& allocation, VkBuffer buffer, VkDeviceSize offset = 0);
+
+// record copy of staging range (tightly packed texels) to color image in transfer destination layout
+void RecordStagingCopy(VkCommandBuffer commandBuffer, const StagingAllocation& allocation, VkImage image, VkImageLayout imageLayout, VkExtent3D extent);
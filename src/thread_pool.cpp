@@ -0,0 +1,46 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+// create pool
+ThreadPool::ThreadPool(uint32_t workerCount) {
+    if (workerCount == 0) workerCount = std::max(1u, std::thread::hardware_concurrency());
+    for (uint32_t i = 0; i < workerCount; i++)
+        workers.emplace_back(&ThreadPool::WorkerMain, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+// submit task
+std::future<void> ThreadPool::Submit(Task task, TaskPriority priority) {
+    std::packaged_task<void(uint32_t)> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        (priority == TaskPriority::High ? highTasks : tasks).push_back(std::move(packagedTask));
+    }
+    condition.notify_one();
+    return future;
+}
+
+// worker loop: run tasks (high priority first) until pool is stopping and queues are empty
+void ThreadPool::WorkerMain(uint32_t workerIndex) {
+    for (;;) {
+        std::packaged_task<void(uint32_t)> task{};
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty() || !highTasks.empty(); });
+            auto& queue = highTasks.empty() ? tasks : highTasks;
+            if (queue.empty()) return;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task(workerIndex);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <future>
+#include <functional>
+#include <condition_variable>
+
+// task priority, high priority tasks run before every queued normal priority task
+enum class TaskPriority { Normal, High };
+
+// fixed size worker pool, tasks get index of worker running them
+class ThreadPool {
+public:
+    using Task = std::function<void(uint32_t workerIndex)>;
+    // create pool, zero worker count means hardware concurrency
+    explicit ThreadPool(uint32_t workerCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // submit task, returned future is ready when task is done
+    std::future<void> Submit(Task task, TaskPriority priority = TaskPriority::Normal);
+    // get worker count
+    uint32_t GetWorkerCount() const { return (uint32_t)workers.size(); }
+private:
+    void WorkerMain(uint32_t workerIndex);
+    std::vector<std::thread> workers{};
+    std::deque<std::packaged_task<void(uint32_t)>> tasks{};     // normal priority
+    std::deque<std::packaged_task<void(uint32_t)>> highTasks{}; // high priority
+    std::mutex mutex{};
+    std::condition_variable condition{};
+    bool stopping{};
+};
@@ -0,0 +1,167 @@
+#include "tuning.hpp"
+#include "hash.hpp"
+#include "bench.hpp"
+#include <array>
+#include <chrono>
+#include <thread>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+// tuning database file format version
+static const char* tuningDatabaseHeader = "vkc-tuning 1";
+
+// get key text
+std::string TuningDeviceKey::ToString() const {
+    std::string text = std::to_string(vendorID) + " " + std::to_string(deviceID) + " " + std::to_string(driverVersion) + " ";
+    static const char digits[] = "0123456789abcdef";
+    for (uint8_t byte : pipelineCacheUUID) {
+        text += digits[byte >> 4];
+        text += digits[byte & 0xf];
+    }
+    return text;
+}
+
+// get tuning device key
+TuningDeviceKey GetTuningDeviceKey(const VkPhysicalDeviceProperties& properties) {
+    TuningDeviceKey deviceKey{};
+    deviceKey.vendorID = properties.vendorID;
+    deviceKey.deviceID = properties.deviceID;
+    deviceKey.driverVersion = properties.driverVersion;
+    std::copy(std::begin(properties.pipelineCacheUUID), std::end(properties.pipelineCacheUUID), deviceKey.pipelineCacheUUID);
+    return deviceKey;
+}
+
+// get problem size bucket
+std::string GetProblemSizeBucket(const uint32_t problemSize[3]) {
+    std::string bucket{};
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t size = 1;
+        while (size < problemSize[i] && size < 0x80000000u) size <<= 1;
+        bucket += (i ? "x" : "") + std::to_string(size);
+    }
+    return bucket;
+}
+
+// parse whole field as unsigned integer, returns false on junk or overflow
+template <typename T>
+static bool ParseField(std::string_view text, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+// load database of device
+TuningDatabase::TuningDatabase(const std::filesystem::path& directory, const TuningDeviceKey& deviceKey) : deviceKey(deviceKey) {
+    path = directory / (HashToString(Hasher().Add(deviceKey.ToString()).value) + ".tuning");
+    std::ifstream file(path);
+    std::string line{};
+    if (!std::getline(file, line) || line != tuningDatabaseHeader) return;
+    if (!std::getline(file, line) || line != "device " + deviceKey.ToString()) return;
+    // "<kernel> <bucket> <gpu ms> <id>=<value> ...", malformed lines (hand edited or corrupt) are skipped
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string kernel{}, bucket{};
+        TuningResult result{};
+        if (!(fields >> kernel >> bucket >> result.gpuMs)) continue;
+        bool valid = true;
+        for (std::string constant{}; valid && fields >> constant;) {
+            const size_t separator = constant.find('=');
+            uint32_t specId{};
+            uint64_t value{};
+            valid = separator != std::string::npos && ParseField(std::string_view(constant).substr(0, separator), specId) &&
+                ParseField(std::string_view(constant).substr(separator + 1), value);
+            if (valid) result.constants.Set(specId, value);
+        }
+        if (valid) results[{ kernel, bucket }] = result;
+    }
+}
+
+// find tuning result
+const TuningResult* TuningDatabase::Find(const std::string& kernel, const std::string& bucket) const {
+    auto result = results.find({ kernel, bucket });
+    return result == results.end() ? nullptr : &result->second;
+}
+
+// store tuning result
+void TuningDatabase::Store(const std::string& kernel, const std::string& bucket, const TuningResult& result) {
+    results[{ kernel, bucket }] = result;
+}
+
+// save database (temporary file + rename)
+bool TuningDatabase::Save() const {
+    std::error_code errorCode{};
+    std::filesystem::create_directories(path.parent_path(), errorCode);
+    const uint64_t tempId = Hasher()
+        .AddValue(std::hash<std::thread::id>()(std::this_thread::get_id()))
+        .AddValue(std::chrono::steady_clock::now().time_since_epoch().count()).value;
+    std::filesystem::path tempPath = path;
+    tempPath += "." + HashToString(tempId) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        file << tuningDatabaseHeader << "\n";
+        file << "device " << deviceKey.ToString() << "\n";
+        for (const auto& [key, result] : results) {
+            file << key.first << " " << key.second << " " << result.gpuMs;
+            for (const auto& [id, value] : result.constants.values) file << " " << id << "=" << value;
+            file << "\n";
+        }
+        if (!file) {
+            std::cout << "Tuning database: can't write " << tempPath << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, path, errorCode);
+    if (errorCode) {
+        std::cout << "Tuning database: can't write " << path << ": " << errorCode.message() << std::endl;
+        std::filesystem::remove(tempPath, errorCode);
+        return false;
+    }
+    return true;
+}
+
+// autotune workgroup size of kernel
+TuningResult AutotuneKernel(SpecializedKernel& kernel, VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod,
+    const VkPhysicalDeviceLimits& limits, uint32_t subgroupSize, const TuningBind& bind, const TuningDispatch& recordDispatch) {
+    TuningResult best{};
+    best.gpuMs = -1.0;
+    const SpirvReflection& reflection = kernel.GetReflection();
+
+    // candidate shapes: power of two per tunable dimension, at least one subgroup, within workgroup limits
+    std::vector<uint32_t> dimensionSizes[3]{};
+    for (uint32_t i = 0; i < 3; i++) {
+        if (reflection.localSizeSpecIds[i] == UINT32_MAX) dimensionSizes[i].push_back(reflection.localSize[i]);
+        else for (uint32_t size = 1; size <= limits.maxComputeWorkGroupSize[i] && size <= limits.maxComputeWorkGroupInvocations; size <<= 1) dimensionSizes[i].push_back(size);
+    }
+    std::vector<std::array<uint32_t, 3>> candidates{};
+    for (uint32_t x : dimensionSizes[0])
+        for (uint32_t y : dimensionSizes[1])
+            for (uint32_t z : dimensionSizes[2]) {
+                const uint64_t invocations = (uint64_t)x * y * z;
+                if (invocations >= std::max(1u, subgroupSize) && invocations <= limits.maxComputeWorkGroupInvocations)
+                    candidates.push_back({ x, y, z });
+            }
+
+    // benchmark candidates (pipelines stay cached in kernel)
+    for (const auto& candidate : candidates) {
+        SpecConstants constants = SpecConstants().SetLocalSize(reflection, candidate[0], candidate[1], candidate[2]);
+        const KernelProgram program = kernel.GetPipeline(constants);
+        if (!program) continue;
+        uint32_t localSize[3]{};
+        GetSpecializedLocalSize(reflection, constants, localSize);
+        // warm up, then measure
+        bool bound = true;
+        auto setup = [&](VkCommandBuffer commandBuffer) { return bound = !bind || bind(commandBuffer); };
+        auto record = [&](VkCommandBuffer commandBuffer) { recordDispatch(commandBuffer, program, localSize); };
+        MeasureGpuTimeMs(device, queue, queueFamilyIndex, timestampPeriod, record, 1, setup);
+        const double gpuMs = bound ? MeasureGpuTimeMs(device, queue, queueFamilyIndex, timestampPeriod, record, 20, setup) : -1.0;
+        if (!bound) continue;
+        if (gpuMs < 0.0) return best;
+        if (best.gpuMs < 0.0 || gpuMs < best.gpuMs) {
+            best.constants = constants;
+            best.gpuMs = gpuMs;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <filesystem>
+#include "vulkan_loader.hpp"
+#include "specialization.hpp"
+
+// device identity of tuning results: results are only valid for same device, driver and pipeline cache
+struct TuningDeviceKey {
+    uint32_t vendorID{};
+    uint32_t deviceID{};
+    uint32_t driverVersion{};
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE]{};
+    // get key text "<vendor> <device> <driver> <uuid>"
+    std::string ToString() const;
+};
+
+// get tuning device key
+TuningDeviceKey GetTuningDeviceKey(const VkPhysicalDeviceProperties& properties);
+
+// get problem size bucket "<x>x<y>x<z>", dimensions are rounded up to power of two
+std::string GetProblemSizeBucket(const uint32_t problemSize[3]);
+
+// tuning result
+struct TuningResult {
+    SpecConstants constants{};
+    double gpuMs{};
+};
+
+// per device tuning database: best constants per kernel and problem size bucket
+// one text file per device ("<directory>/<device key hash>.tuning"), saved atomically
+class TuningDatabase {
+public:
+    // load database of device, missing or foreign file gives empty database, malformed lines are skipped
+    TuningDatabase(const std::filesystem::path& directory, const TuningDeviceKey& deviceKey);
+    // find tuning result, returns null if kernel was not tuned for bucket
+    const TuningResult* Find(const std::string& kernel, const std::string& bucket) const;
+    // store tuning result
+    void Store(const std::string& kernel, const std::string& bucket, const TuningResult& result);
+    // save database, returns false on failure
+    bool Save() const;
+    // get count of results
+    size_t GetResultCount() const { return results.size(); }
+private:
+    std::filesystem::path path{};
+    TuningDeviceKey deviceKey{};
+    std::map<std::pair<std::string, std::string>, TuningResult> results{}; // (kernel, bucket) -> result
+};
+
+// record dispatch of specialized pipeline with its workgroup size (dispatch covers problem size)
+using TuningDispatch = std::function<void(VkCommandBuffer commandBuffer, const KernelProgram& program, const uint32_t localSize[3])>;
+
+// bind kernel resources and record its parameters once per measurement (shared by specialized pipelines of kernel layout),
+// returns false when resources are not bound, empty for kernels without descriptors and push constants
+using TuningBind = std::function<bool(VkCommandBuffer commandBuffer)>;
+
+// autotune workgroup size of kernel: benchmark candidate local sizes with gpu timestamps and return the fastest
+// candidates are power of two shapes within device limits (local_size_*_id dimensions only), candidates with unbound resources are skipped,
+// failure gives negative gpu time
+TuningResult AutotuneKernel(SpecializedKernel& kernel, VkDevice device, VkQueue queue, uint32_t queueFamilyIndex, float timestampPeriod,
+    const VkPhysicalDeviceLimits& limits, uint32_t subgroupSize, const TuningBind& bind, const TuningDispatch& recordDispatch);
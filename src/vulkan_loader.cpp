@@ -0,0 +1,68 @@
+#include "vulkan_loader.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+// function pointers
+#define VULKAN_DEFINE_FUNCTION(name) PFN_##name name = nullptr;
+PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr = nullptr;
+VULKAN_GLOBAL_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+VULKAN_INSTANCE_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+VULKAN_DEVICE_FUNCTIONS(VULKAN_DEFINE_FUNCTION)
+#undef VULKAN_DEFINE_FUNCTION
+
+// vulkan library handle
+static void* vulkanLibrary = nullptr;
+
+// load vulkan library and global functions
+bool LoadVulkanLibrary() {
+#if defined(_WIN32)
+    HMODULE module = LoadLibraryA("vulkan-1.dll");
+    if (!module) return false;
+    vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)(void(*)(void))GetProcAddress(module, "vkGetInstanceProcAddr");
+    vulkanLibrary = (void*)module;
+#else
+#if defined(__APPLE__)
+    void* module = dlopen("libvulkan.1.dylib", RTLD_NOW | RTLD_LOCAL);
+#else
+    void* module = dlopen("libvulkan.so.1", RTLD_NOW | RTLD_LOCAL);
+    if (!module) module = dlopen("libvulkan.so", RTLD_NOW | RTLD_LOCAL);
+#endif
+    if (!module) return false;
+    vkGetInstanceProcAddr = (PFN_vkGetInstanceProcAddr)dlsym(module, "vkGetInstanceProcAddr");
+    vulkanLibrary = module;
+#endif
+    if (!vkGetInstanceProcAddr) return false;
+    #define VULKAN_LOAD_FUNCTION(name) name = (PFN_##name)vkGetInstanceProcAddr(VK_NULL_HANDLE, #name);
+    VULKAN_GLOBAL_FUNCTIONS(VULKAN_LOAD_FUNCTION)
+    #undef VULKAN_LOAD_FUNCTION
+    return true;
+}
+
+// load instance functions
+void LoadVulkanInstance(VkInstance instance) {
+    #define VULKAN_LOAD_FUNCTION(name) name = (PFN_##name)vkGetInstanceProcAddr(instance, #name);
+    VULKAN_INSTANCE_FUNCTIONS(VULKAN_LOAD_FUNCTION)
+    VULKAN_DEVICE_FUNCTIONS(VULKAN_LOAD_FUNCTION)
+    #undef VULKAN_LOAD_FUNCTION
+}
+
+// load device functions directly from driver
+void LoadVulkanDevice(VkDevice device) {
+    #define VULKAN_LOAD_FUNCTION(name) name = (PFN_##name)vkGetDeviceProcAddr(device, #name);
+    VULKAN_DEVICE_FUNCTIONS(VULKAN_LOAD_FUNCTION)
+    #undef VULKAN_LOAD_FUNCTION
+}
+
+// unload vulkan library
+void UnloadVulkanLibrary() {
+    if (!vulkanLibrary) return;
+#ifdef _WIN32
+    FreeLibrary((HMODULE)vulkanLibrary);
+#else
+    dlclose(vulkanLibrary);
+#endif
+    vulkanLibrary = nullptr;
+}
@@ -0,0 +1,150 @@
+#pragma once
+// vulkan meta-loader: no link-time dependency on vulkan library,
+// device functions are loaded by vkGetDeviceProcAddr and bypass loader trampolines
+#if defined(VULKAN_H_) && !defined(VK_NO_PROTOTYPES)
+#error "vulkan.h included without VK_NO_PROTOTYPES, include vulkan_loader.hpp first"
+#endif
+#ifndef VK_NO_PROTOTYPES
+#define VK_NO_PROTOTYPES
+#endif
+#include <vulkan/vulkan.h>
+
+// global functions (loaded from library)
+#define VULKAN_GLOBAL_FUNCTIONS(X) \
+    X(vkCreateInstance) \
+    X(vkEnumerateInstanceVersion) \
+    X(vkEnumerateInstanceLayerProperties) \
+    X(vkEnumerateInstanceExtensionProperties)
+
+// instance functions (loaded by vkGetInstanceProcAddr)
+#define VULKAN_INSTANCE_FUNCTIONS(X) \
+    X(vkDestroyInstance) \
+    X(vkEnumeratePhysicalDevices) \
+    X(vkEnumerateDeviceExtensionProperties) \
+    X(vkGetPhysicalDeviceProperties) \
+    X(vkGetPhysicalDeviceProperties2) \
+    X(vkGetPhysicalDeviceFeatures2) \
+    X(vkGetPhysicalDeviceFormatProperties) \
+    X(vkGetPhysicalDeviceMemoryProperties) \
+    X(vkGetPhysicalDeviceMemoryProperties2) \
+    X(vkGetPhysicalDeviceQueueFamilyProperties) \
+    X(vkCreateDevice) \
+    X(vkGetDeviceProcAddr)
+
+// device functions (loaded by vkGetDeviceProcAddr)
+#define VULKAN_DEVICE_FUNCTIONS(X) \
+    X(vkDestroyDevice) \
+    X(vkDeviceWaitIdle) \
+    X(vkGetDeviceQueue) \
+    X(vkQueueSubmit) \
+    X(vkQueueWaitIdle) \
+    X(vkAllocateMemory) \
+    X(vkFreeMemory) \
+    X(vkMapMemory) \
+    X(vkUnmapMemory) \
+    X(vkFlushMappedMemoryRanges) \
+    X(vkInvalidateMappedMemoryRanges) \
+    X(vkBindBufferMemory) \
+    X(vkBindImageMemory) \
+    X(vkBindBufferMemory2) \
+    X(vkBindImageMemory2) \
+    X(vkGetBufferMemoryRequirements) \
+    X(vkGetImageMemoryRequirements) \
+    X(vkGetBufferMemoryRequirements2) \
+    X(vkGetImageMemoryRequirements2) \
+    X(vkGetDeviceBufferMemoryRequirements) \
+    X(vkGetDeviceImageMemoryRequirements) \
+    X(vkCreateBuffer) \
+    X(vkDestroyBuffer) \
+    X(vkGetBufferDeviceAddress) \
+    X(vkCreateImage) \
+    X(vkDestroyImage) \
+    X(vkCreateImageView) \
+    X(vkDestroyImageView) \
+    X(vkCreateShaderModule) \
+    X(vkDestroyShaderModule) \
+    X(vkCreatePipelineLayout) \
+    X(vkDestroyPipelineLayout) \
+    X(vkCreateComputePipelines) \
+    X(vkDestroyPipeline) \
+    X(vkCreatePipelineCache) \
+    X(vkDestroyPipelineCache) \
+    X(vkGetPipelineCacheData) \
+    X(vkMergePipelineCaches) \
+    X(vkCreateDescriptorSetLayout) \
+    X(vkDestroyDescriptorSetLayout) \
+    X(vkCreateDescriptorPool) \
+    X(vkDestroyDescriptorPool) \
+    X(vkResetDescriptorPool) \
+    X(vkAllocateDescriptorSets) \
+    X(vkFreeDescriptorSets) \
+    X(vkUpdateDescriptorSets) \
+    X(vkCreateDescriptorUpdateTemplate) \
+    X(vkDestroyDescriptorUpdateTemplate) \
+    X(vkUpdateDescriptorSetWithTemplate) \
+    X(vkCreateFence) \
+    X(vkDestroyFence) \
+    X(vkResetFences) \
+    X(vkGetFenceStatus) \
+    X(vkWaitForFences) \
+    X(vkCreateSemaphore) \
+    X(vkDestroySemaphore) \
+    X(vkWaitSemaphores) \
+    X(vkSignalSemaphore) \
+    X(vkGetSemaphoreCounterValue) \
+    X(vkCreateQueryPool) \
+    X(vkDestroyQueryPool) \
+    X(vkResetQueryPool) \
+    X(vkGetQueryPoolResults) \
+    X(vkCreateCommandPool) \
+    X(vkDestroyCommandPool) \
+    X(vkResetCommandPool) \
+    X(vkAllocateCommandBuffers) \
+    X(vkFreeCommandBuffers) \
+    X(vkBeginCommandBuffer) \
+    X(vkEndCommandBuffer) \
+    X(vkResetCommandBuffer) \
+    X(vkCmdBindPipeline) \
+    X(vkCmdBindDescriptorSets) \
+    X(vkCmdPushConstants) \
+    X(vkCmdDispatch) \
+    X(vkCmdDispatchIndirect) \
+    X(vkCmdCopyBuffer) \
+    X(vkCmdCopyBufferToImage) \
+    X(vkCmdCopyImageToBuffer) \
+    X(vkCmdFillBuffer) \
+    X(vkCmdUpdateBuffer) \
+    X(vkCmdPipelineBarrier) \
+    X(vkCmdResetQueryPool) \
+    X(vkCmdWriteTimestamp) \
+    X(vkCreateShadersEXT) \
+    X(vkDestroyShaderEXT) \
+    X(vkGetShaderBinaryDataEXT) \
+    X(vkCmdBindShadersEXT) \
+    X(vkCmdPushDescriptorSetKHR) \
+    X(vkCmdPushDescriptorSetWithTemplateKHR) \
+    X(vkGetDescriptorSetLayoutSizeEXT) \
+    X(vkGetDescriptorSetLayoutBindingOffsetEXT) \
+    X(vkGetDescriptorEXT) \
+    X(vkCmdBindDescriptorBuffersEXT) \
+    X(vkCmdSetDescriptorBufferOffsetsEXT)
+
+// function pointers
+#define VULKAN_DECLARE_FUNCTION(name) extern PFN_##name name;
+extern PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
+VULKAN_GLOBAL_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+VULKAN_INSTANCE_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+VULKAN_DEVICE_FUNCTIONS(VULKAN_DECLARE_FUNCTION)
+#undef VULKAN_DECLARE_FUNCTION
+
+// load vulkan library and global functions, returns false if library not found
+bool LoadVulkanLibrary();
+
+// load instance functions (device functions are loaded as loader trampolines)
+void LoadVulkanInstance(VkInstance instance);
+
+// load device functions directly from driver
+void LoadVulkanDevice(VkDevice device);
+
+// unload vulkan library
+void UnloadVulkanLibrary();